@@ -29,15 +29,28 @@
 #include <sdbus-c++/Message.h>
 #include <sdbus-c++/TypeTraits.h>
 #include <sdbus-c++/Flags.h>
+#include <sdbus-c++/SignalFilter.h>
+#include <sdbus-c++/Task.h>
 #include <string>
 #include <type_traits>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <tuple>
+#include <exception>
+#include <atomic>
 
 // Forward declarations
 namespace sdbus {
     class IObject;
     class IObjectProxy;
+    class IExecutor;
+    class PendingAsyncCall;
     class Variant;
     class Error;
+#ifdef SDBUS_HAS_COROUTINES
+    template <typename... _Results> class AsyncMethodAwaitable;
+#endif
 }
 
 namespace sdbus {
@@ -52,12 +65,17 @@ namespace sdbus {
 
         MethodRegistrator& onInterface(const std::string& interfaceName);
         template <typename _Function>
-        std::enable_if_t<!is_async_method_v<_Function>, MethodRegistrator&> implementedAs(_Function&& callback);
+        std::enable_if_t<!is_async_method_v<_Function> && !is_coroutine_method_v<_Function>, MethodRegistrator&> implementedAs(_Function&& callback);
         template <typename _Function>
         std::enable_if_t<is_async_method_v<_Function>, MethodRegistrator&> implementedAs(_Function&& callback);
+#ifdef SDBUS_HAS_COROUTINES
+        template <typename _Function>
+        std::enable_if_t<is_coroutine_method_v<_Function>, MethodRegistrator&> implementedAs(_Function&& callback);
+#endif
         MethodRegistrator& markAsDeprecated();
         MethodRegistrator& markAsPrivileged();
         MethodRegistrator& withNoReply();
+        MethodRegistrator& executedOn(IExecutor& executor);
 
     private:
         IObject& object_;
@@ -68,6 +86,7 @@ namespace sdbus {
         method_callback syncCallback_;
         async_method_callback asyncCallback_;
         Flags flags_;
+        IExecutor* executor_{};
         int exceptions_{}; // Number of active exceptions when SignalRegistrator is constructed
     };
 
@@ -164,6 +183,9 @@ namespace sdbus {
         ~MethodInvoker() noexcept(false);
 
         MethodInvoker& onInterface(const std::string& interfaceName);
+        MethodInvoker& withTimeout(uint64_t usec);
+        template <typename _Rep, typename _Period>
+        MethodInvoker& withTimeout(const std::chrono::duration<_Rep, _Period>& timeout);
         template <typename... _Args> MethodInvoker& withArguments(_Args&&... args);
         template <typename... _Args> void storeResultsTo(_Args&... args);
 
@@ -173,6 +195,7 @@ namespace sdbus {
         IObjectProxy& objectProxy_;
         const std::string& methodName_;
         MethodCall method_;
+        uint64_t timeout_{};
         int exceptions_{}; // Number of active exceptions when MethodInvoker is constructed
         bool methodCalled_{};
     };
@@ -182,26 +205,63 @@ namespace sdbus {
     public:
         AsyncMethodInvoker(IObjectProxy& objectProxy, const std::string& methodName);
         AsyncMethodInvoker& onInterface(const std::string& interfaceName);
+        AsyncMethodInvoker& withTimeout(uint64_t usec);
+        template <typename _Rep, typename _Period>
+        AsyncMethodInvoker& withTimeout(const std::chrono::duration<_Rep, _Period>& timeout);
         template <typename... _Args> AsyncMethodInvoker& withArguments(_Args&&... args);
-        template <typename _Function> void uponReplyInvoke(_Function&& callback);
+        template <typename _Function> PendingAsyncCall uponReplyInvoke(_Function&& callback);
+        template <typename... _Results> std::future<future_return_t<_Results...>> getResultAsFuture();
+#ifdef SDBUS_HAS_COROUTINES
+        template <typename... _Results> AsyncMethodAwaitable<_Results...> getResultAsAwaitable();
+        template <typename... _Results> AsyncMethodAwaitable<_Results...> getResultAsAwaitable(IExecutor& executor);
+#endif
 
     private:
         IObjectProxy& objectProxy_;
         const std::string& methodName_;
         AsyncMethodCall method_;
+        uint64_t timeout_{};
+    };
+
+#ifdef SDBUS_HAS_COROUTINES
+    template <typename... _Results>
+    class AsyncMethodAwaitable
+    {
+    public:
+        explicit AsyncMethodAwaitable(AsyncMethodInvoker invoker, IExecutor* executor = nullptr);
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> handle);
+        future_return_t<_Results...> await_resume();
+
+    private:
+        class Completion;
+        void complete(std::coroutine_handle<> handle);
+        void resume(std::coroutine_handle<> handle);
+
+        AsyncMethodInvoker invoker_;
+        IExecutor* executor_;
+        std::tuple<_Results...> results_;
+        std::exception_ptr error_;
+        std::atomic<bool> completed_{};
     };
+#endif
 
     class SignalSubscriber
     {
     public:
         SignalSubscriber(IObjectProxy& objectProxy, const std::string& signalName);
         SignalSubscriber& onInterface(const std::string& interfaceName);
+        SignalSubscriber& whereArgument(unsigned index, const std::string& value);
+        SignalSubscriber& whereArgumentPath(unsigned index, const std::string& path);
+        SignalSubscriber& whereArgument0Namespace(const std::string& nameSpace);
+        SignalSubscriber& inPathNamespace();
         template <typename _Function> void call(_Function&& callback);
 
     private:
         IObjectProxy& objectProxy_;
         std::string signalName_;
         std::string interfaceName_;
+        SignalFilter filter_;
     };
 
     class PropertyGetter
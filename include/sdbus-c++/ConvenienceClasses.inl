@@ -33,8 +33,10 @@
 #include <sdbus-c++/Types.h>
 #include <sdbus-c++/TypeTraits.h>
 #include <sdbus-c++/Error.h>
+#include <sdbus-c++/IExecutor.h>
 #include <string>
 #include <tuple>
+#include <memory>
 /*#include <exception>*/
 
 namespace sdbus {
@@ -82,7 +84,7 @@ namespace sdbus {
     }
 
     template <typename _Function>
-    inline std::enable_if_t<!is_async_method_v<_Function>, MethodRegistrator&> MethodRegistrator::implementedAs(_Function&& callback)
+    inline std::enable_if_t<!is_async_method_v<_Function> && !is_coroutine_method_v<_Function>, MethodRegistrator&> MethodRegistrator::implementedAs(_Function&& callback)
     {
         inputSignature_ = signature_of_function_input_arguments<_Function>::str();
         outputSignature_ = signature_of_function_output_arguments<_Function>::str();
@@ -129,6 +131,76 @@ namespace sdbus {
         return *this;
     }
 
+#ifdef SDBUS_HAS_COROUTINES
+    template <typename _Function>
+    inline std::enable_if_t<is_coroutine_method_v<_Function>, MethodRegistrator&> MethodRegistrator::implementedAs(_Function&& callback)
+    {
+        inputSignature_ = signature_of_function_input_arguments<_Function>::str();
+        outputSignature_ = signature_of_function_output_arguments<_Function>::str();
+        asyncCallback_ = [callback = std::forward<_Function>(callback)](MethodCall msg, MethodResult&& /*result*/)
+        {
+            // Create a tuple of callback input arguments' types, which will be used
+            // as a storage for the argument values deserialized from the message.
+            // Reference parameters of the coroutine refer into the tuple, so it lives
+            // on the heap, owned by the completion, until the coroutine is done.
+            auto inputArgs = std::make_shared<tuple_of_function_input_arg_types_t<_Function>>();
+
+            // Deserialize input arguments from the message into the tuple.
+            msg >> *inputArgs;
+
+            // Invoke callback with input arguments from the tuple, getting the coroutine task.
+            // Unlike sdbus::apply, std::apply forwards the task even if the task itself yields void.
+            // Parameters taken by value are moved out, those taken by reference bind to the tuple elements.
+            auto task = std::apply(callback, std::move(*inputArgs));
+
+            // Run the coroutine up to its first suspension point. From there on, it lives on its own
+            // and gets resumed by whatever it awaits; once it returns, we send the reply.
+            // The completion runs within the final suspension of the coroutine, where no exception
+            // may escape, so whatever the coroutine throws is turned into an error reply.
+            using task_type = decltype(task);
+            std::move(task).startDetached([msg = std::move(msg), inputArgs = std::move(inputArgs)](typename task_type::promise_type& promise)
+            {
+                auto sendErrorReply = [&msg](const sdbus::Error& error) noexcept
+                {
+                    try
+                    {
+                        if (!msg.doesntExpectReply())
+                            msg.createErrorReply(error).send();
+                    }
+                    catch (...)
+                    {
+                        // There is no one left to report the failure to
+                    }
+                };
+
+                try
+                {
+                    auto reply = msg.createReply();
+                    if constexpr (std::is_void_v<function_result_t<_Function>>)
+                        promise.result();
+                    else
+                        reply << promise.result();
+                    reply.send();
+                }
+                catch (const sdbus::Error& e)
+                {
+                    sendErrorReply(e);
+                }
+                catch (const std::exception& e)
+                {
+                    sendErrorReply(sdbus::Error("org.freedesktop.DBus.Error.Failed", e.what()));
+                }
+                catch (...)
+                {
+                    sendErrorReply(sdbus::Error("org.freedesktop.DBus.Error.Failed", "Unknown error"));
+                }
+            });
+        };
+
+        return *this;
+    }
+#endif
+
     inline MethodRegistrator& MethodRegistrator::markAsDeprecated()
     {
         flags_.set(Flags::DEPRECATED);
@@ -150,6 +222,13 @@ namespace sdbus {
         return *this;
     }
 
+    inline MethodRegistrator& MethodRegistrator::executedOn(IExecutor& executor)
+    {
+        executor_ = &executor;
+
+        return *this;
+    }
+
 
     // Moved into the library to isolate from C++17 dependency
     /*
@@ -457,6 +536,20 @@ namespace sdbus {
         return *this;
     }
 
+    inline MethodInvoker& MethodInvoker::withTimeout(uint64_t usec)
+    {
+        timeout_ = usec;
+
+        return *this;
+    }
+
+    template <typename _Rep, typename _Period>
+    inline MethodInvoker& MethodInvoker::withTimeout(const std::chrono::duration<_Rep, _Period>& timeout)
+    {
+        auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(timeout);
+        return withTimeout(microsecs.count());
+    }
+
     template <typename... _Args>
     inline MethodInvoker& MethodInvoker::withArguments(_Args&&... args)
     {
@@ -472,7 +565,7 @@ namespace sdbus {
     {
         SDBUS_THROW_ERROR_IF(!method_.isValid(), "DBus interface not specified when calling a DBus method", EINVAL);
 
-        auto reply = objectProxy_.callMethod(method_);
+        auto reply = objectProxy_.callMethod(method_, timeout_);
         methodCalled_ = true;
 
         detail::deserialize_pack(reply, args...);
@@ -499,6 +592,20 @@ namespace sdbus {
         return *this;
     }
 
+    inline AsyncMethodInvoker& AsyncMethodInvoker::withTimeout(uint64_t usec)
+    {
+        timeout_ = usec;
+
+        return *this;
+    }
+
+    template <typename _Rep, typename _Period>
+    inline AsyncMethodInvoker& AsyncMethodInvoker::withTimeout(const std::chrono::duration<_Rep, _Period>& timeout)
+    {
+        auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(timeout);
+        return withTimeout(microsecs.count());
+    }
+
     template <typename... _Args>
     inline AsyncMethodInvoker& AsyncMethodInvoker::withArguments(_Args&&... args)
     {
@@ -510,11 +617,11 @@ namespace sdbus {
     }
 
     template <typename _Function>
-    void AsyncMethodInvoker::uponReplyInvoke(_Function&& callback)
+    PendingAsyncCall AsyncMethodInvoker::uponReplyInvoke(_Function&& callback)
     {
         SDBUS_THROW_ERROR_IF(!method_.isValid(), "DBus interface not specified when calling a DBus method", EINVAL);
 
-        objectProxy_.callMethod(method_, [callback = std::forward<_Function>(callback)](MethodReply& reply, const Error* error)
+        return objectProxy_.callMethod(method_, [callback = std::forward<_Function>(callback)](MethodReply& reply, const Error* error)
         {
             // Create a tuple of callback input arguments' types, which will be used
             // as a storage for the argument values deserialized from the message.
@@ -526,9 +633,162 @@ namespace sdbus {
 
             // Invoke callback with input arguments from the tuple.
             sdbus::apply(callback, error, args); // TODO: Use std::apply when switching to full C++17 support
+        }, timeout_);
+    }
+
+    template <typename... _Results>
+    inline std::future<future_return_t<_Results...>> AsyncMethodInvoker::getResultAsFuture()
+    {
+        auto promise = std::make_shared<std::promise<future_return_t<_Results...>>>();
+        auto future = promise->get_future();
+
+        // If the call gets cancelled, the promise is destroyed unfulfilled and the future reports a broken promise
+        uponReplyInvoke([promise = std::move(promise)](const Error* error, _Results... results)
+        {
+            if (error != nullptr)
+                promise->set_exception(std::make_exception_ptr(*error));
+            else if constexpr (sizeof...(_Results) == 0)
+                promise->set_value();
+            else if constexpr (sizeof...(_Results) == 1)
+                promise->set_value(std::move(results)...);
+            else
+                promise->set_value(std::make_tuple(std::move(results)...));
         });
+
+        return future;
+    }
+
+#ifdef SDBUS_HAS_COROUTINES
+    template <typename... _Results>
+    inline AsyncMethodAwaitable<_Results...> AsyncMethodInvoker::getResultAsAwaitable()
+    {
+        SDBUS_THROW_ERROR_IF(!method_.isValid(), "DBus interface not specified when calling a DBus method", EINVAL);
+
+        return AsyncMethodAwaitable<_Results...>{*this};
+    }
+
+    template <typename... _Results>
+    inline AsyncMethodAwaitable<_Results...> AsyncMethodInvoker::getResultAsAwaitable(IExecutor& executor)
+    {
+        SDBUS_THROW_ERROR_IF(!method_.isValid(), "DBus interface not specified when calling a DBus method", EINVAL);
+
+        return AsyncMethodAwaitable<_Results...>{*this, &executor};
     }
 
+    // Owned by the reply handler of the call. If the handler goes away uncalled, the call was
+    // cancelled, and the coroutine is resumed with an error instead of being left suspended forever.
+    template <typename... _Results>
+    class AsyncMethodAwaitable<_Results...>::Completion
+    {
+    public:
+        Completion(AsyncMethodAwaitable& awaitable, std::coroutine_handle<> handle)
+            : awaitable_(awaitable)
+            , handle_(handle)
+        {
+        }
+
+        Completion(const Completion&) = delete;
+        Completion& operator=(const Completion&) = delete;
+
+        void operator()(const Error* error, _Results... results)
+        {
+            if (error != nullptr)
+                awaitable_.error_ = std::make_exception_ptr(*error);
+            else
+                awaitable_.results_ = std::make_tuple(std::move(results)...);
+
+            replied_ = true;
+            awaitable_.complete(handle_);
+        }
+
+        ~Completion()
+        {
+            if (replied_)
+                return;
+
+            awaitable_.error_ = std::make_exception_ptr(createError(ECANCELED, "Method call was cancelled before its reply arrived"));
+            awaitable_.complete(handle_);
+        }
+
+    private:
+        AsyncMethodAwaitable& awaitable_;
+        std::coroutine_handle<> handle_;
+        bool replied_{};
+    };
+
+    template <typename... _Results>
+    inline AsyncMethodAwaitable<_Results...>::AsyncMethodAwaitable(AsyncMethodInvoker invoker, IExecutor* executor)
+        : invoker_(std::move(invoker))
+        , executor_(executor)
+    {
+    }
+
+    template <typename... _Results>
+    inline bool AsyncMethodAwaitable<_Results...>::await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename... _Results>
+    inline bool AsyncMethodAwaitable<_Results...>::await_suspend(std::coroutine_handle<> handle)
+    {
+        // The call is only issued now that the coroutine is suspended. Its reply may arrive, or the call
+        // may get cancelled, before uponReplyInvoke() returns. Whichever of the two sides comes second
+        // resumes the coroutine; nothing of this object may be touched after that, as it may be gone already.
+        // If sending the call fails, the completion is dropped first and the exception resumes the coroutine.
+        auto completion = std::make_shared<Completion>(*this, handle);
+        invoker_.uponReplyInvoke([completion = std::move(completion)](const Error* error, _Results... results)
+        {
+            (*completion)(error, std::move(results)...);
+        });
+
+        // The call has not completed yet, it resumes the coroutine once it does
+        if (!completed_.exchange(true))
+            return true;
+
+        if (executor_ == nullptr)
+            return false;
+
+        resume(handle);
+        return true;
+    }
+
+    template <typename... _Results>
+    inline void AsyncMethodAwaitable<_Results...>::complete(std::coroutine_handle<> handle)
+    {
+        // The coroutine is not suspended yet, await_suspend() resumes it
+        if (!completed_.exchange(true))
+            return;
+
+        resume(handle);
+    }
+
+    template <typename... _Results>
+    inline void AsyncMethodAwaitable<_Results...>::resume(std::coroutine_handle<> handle)
+    {
+        // Without an executor, the coroutine resumes in the thread that completed the call: the connection
+        // event loop thread for replies, the thread destroying the proxy for cancelled calls.
+        if (executor_ == nullptr)
+            handle.resume();
+        else
+            executor_->execute([handle](){ handle.resume(); });
+    }
+
+    template <typename... _Results>
+    inline future_return_t<_Results...> AsyncMethodAwaitable<_Results...>::await_resume()
+    {
+        if (error_)
+            std::rethrow_exception(error_);
+
+        if constexpr (sizeof...(_Results) == 0)
+            return;
+        else if constexpr (sizeof...(_Results) == 1)
+            return std::move(std::get<0>(results_));
+        else
+            return std::move(results_);
+    }
+#endif
+
 
     inline SignalSubscriber::SignalSubscriber(IObjectProxy& objectProxy, const std::string& signalName)
         : objectProxy_(objectProxy)
@@ -543,6 +803,38 @@ namespace sdbus {
         return *this;
     }
 
+    inline SignalSubscriber& SignalSubscriber::whereArgument(unsigned index, const std::string& value)
+    {
+        SDBUS_THROW_ERROR_IF(index > SignalFilter::MAX_ARGUMENT_INDEX, "Signal argument index out of range", EINVAL);
+
+        filter_.setArgument(index, value);
+
+        return *this;
+    }
+
+    inline SignalSubscriber& SignalSubscriber::whereArgumentPath(unsigned index, const std::string& path)
+    {
+        SDBUS_THROW_ERROR_IF(index > SignalFilter::MAX_ARGUMENT_INDEX, "Signal argument index out of range", EINVAL);
+
+        filter_.setArgumentPath(index, path);
+
+        return *this;
+    }
+
+    inline SignalSubscriber& SignalSubscriber::whereArgument0Namespace(const std::string& nameSpace)
+    {
+        filter_.setArgument0Namespace(nameSpace);
+
+        return *this;
+    }
+
+    inline SignalSubscriber& SignalSubscriber::inPathNamespace()
+    {
+        filter_.setPathNamespace();
+
+        return *this;
+    }
+
     template <typename _Function>
     inline void SignalSubscriber::call(_Function&& callback)
     {
@@ -550,6 +842,7 @@ namespace sdbus {
 
         objectProxy_.registerSignalHandler( interfaceName_
                                           , signalName_
+                                          , filter_
                                           , [callback = std::forward<_Function>(callback)](Signal& signal)
         {
             // Create a tuple of callback input arguments' types, which will be used
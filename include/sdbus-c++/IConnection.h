@@ -26,9 +26,14 @@
 #ifndef SDBUS_CXX_ICONNECTION_H_
 #define SDBUS_CXX_ICONNECTION_H_
 
+#include <sdbus-c++/TypeTraits.h>
 //#include <cstdint>
 #include <string>
+#include <vector>
 #include <memory>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 namespace sdbus {
 
@@ -45,6 +50,58 @@ namespace sdbus {
     class IConnection
     {
     public:
+        /*!
+        * @brief Poll data describing what to wait for before processing the connection again
+        *
+        * @a fd and @a events are to be passed to poll/epoll. @a timeout_usec is an absolute
+        * point in time on CLOCK_MONOTONIC by which the connection has to be processed even
+        * if no event arrives (UINT64_MAX means no timeout, 0 means process immediately).
+        */
+        struct PollData
+        {
+            int fd;
+            short int events;
+            uint64_t timeout_usec;
+
+            /*!
+            * @brief Converts the absolute timeout into a relative one, suitable for poll/epoll_wait
+            *
+            * @return Timeout in milliseconds, or -1 for an infinite timeout
+            */
+            int getPollTimeout() const
+            {
+                if (timeout_usec == UINT64_MAX)
+                    return -1;
+
+                using namespace std::chrono;
+                auto now = duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+                if (timeout_usec <= static_cast<uint64_t>(now))
+                    return 0;
+
+                auto remainingMs = (timeout_usec - now + 999) / 1000; // Round up not to wake up too early
+                return remainingMs > INT32_MAX ? -1 : static_cast<int>(remainingMs);
+            }
+        };
+
+        /*!
+        * @brief Mechanism the processing loop uses to wait for incoming messages
+        */
+        enum class EventLoopBackend
+        {
+            ePoll,      //!< poll() over the bus and internal descriptors on each wakeup (default)
+            eIoUring    //!< io_uring with persistent multishot poll requests, Linux 5.11 or newer
+        };
+
+        /*!
+        * @brief What happens to a message sent while the write queue of the connection is full
+        */
+        enum class OverflowPolicy
+        {
+            eBlock,         //!< The sender waits until the queue drains below the limit
+            eDropNewest,    //!< The message being sent is dropped silently
+            eFailFast       //!< Sending fails with an ENOBUFS error
+        };
+
         /*!
         * @brief Requests D-Bus name on the connection
         *
@@ -90,11 +147,320 @@ namespace sdbus {
         */
         virtual void leaveProcessingLoop() = 0;
 
+        /*!
+        * @brief Returns fd, I/O events and timeout data to be waited on in an external event loop
+        *
+        * This, together with @processPendingRequest, allows to drive the connection from
+        * an event loop of the client (e.g. epoll reactor), instead of using @enterProcessingLoop
+        * or @enterProcessingLoopAsync. Events and timeout may change with every bus operation,
+        * so the poll data shall be obtained anew before each wait.
+        *
+        * @return Current poll data of the underlying bus
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual PollData getEventLoopPollData() const = 0;
+
+        /*!
+        * @brief Processes a pending request, if any, without blocking
+        *
+        * To be called from an external event loop when the connection's fd is ready
+        * or its timeout has elapsed. Call it repeatedly as long as it returns true.
+        *
+        * @return true if a request was processed, false if there was nothing to process
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual bool processPendingRequest() = 0;
+
+        /*!
+        * @brief Sets how much work the processing loop does between looks at its own events
+        *
+        * The processing loop drains pending messages in batches, each limited to @a maxMessages
+        * messages and, if non-zero, to @a maxDuration time. The bus lock is taken per message,
+        * so other threads may use the connection during a batch. Between two batches, the loop
+        * sends the messages queued by other threads (see @c enableOutboundQueue()) and checks,
+        * without blocking, whether it has been asked to exit or to wake up. Bigger batches mean
+        * fewer such rounds per message; smaller batches make the loop react sooner to those events
+        * when messages keep coming. By default, a batch is one message.
+        *
+        * Must be called before the processing loop is entered.
+        *
+        * @param[in] maxMessages Maximum number of messages per batch (0 for no limit)
+        * @param[in] maxDuration Maximum duration of a batch (0 for no limit)
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void setProcessingBudget(std::size_t maxMessages, std::chrono::microseconds maxDuration = std::chrono::microseconds::zero()) = 0;
+
+        /*!
+        * @brief Installs a handler that gets the number of messages drained per processing loop wakeup
+        *
+        * The handler is invoked in the processing loop thread each time the loop has drained all
+        * pending messages and is about to wait for new ones. This helps in tuning the processing budget.
+        *
+        * Must be called before the processing loop is entered.
+        *
+        * @param[in] handler Handler receiving the number of messages drained since the last wakeup
+        */
+        virtual void setDrainReportHandler(drain_report_handler handler) = 0;
+
+        /*!
+        * @brief Enables dispatching of incoming method calls and signals to worker threads
+        *
+        * By default, all method and signal handlers are invoked in the thread running
+        * the processing loop. In multi-threaded dispatch mode, the processing loop thread
+        * only reads messages from the bus and hands method calls and signals over to
+        * a pool of @a workerCount worker threads. Messages with the same dispatch key
+        * are always handled by the same worker, in the order they have arrived. By default,
+        * the dispatch key is the object path of the message, so handlers of one object
+        * never run concurrently, while different objects are served in parallel.
+        *
+        * Property get and set requests are still handled in the processing loop thread.
+        * Objects and proxies wait upon their destruction for their messages still queued or
+        * handled in workers, so they must not be destroyed from within their own handlers.
+        * The mode must be enabled before the processing loop is entered.
+        *
+        * @param[in] workerCount Number of worker threads
+        * @param[in] keyCallback Optional callback providing a custom dispatch key of a message
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void enableMultithreadedDispatch(std::size_t workerCount, dispatch_key_callback keyCallback = {}) = 0;
+
+        /*!
+        * @brief Enables dispatching of incoming method calls and signals to shards pinned to CPUs
+        *
+        * The same as @enableMultithreadedDispatch, except that there is one worker thread, a shard,
+        * per CPU in @a cpus, and each shard is pinned to its CPU. With the default dispatch key, objects
+        * are assigned to shards by object path hash, so each object is served from one CPU only, with
+        * its data staying in that CPU's caches, and its handlers need not be thread-safe across shards.
+        *
+        * All shards are fed by this one connection, which keeps owning the service's well-known
+        * bus name; the bus daemon routes a name to a single connection only, so it is this connection's
+        * processing loop that acts as the front door reading messages off the bus.
+        *
+        * Must be called before the processing loop is entered.
+        *
+        * @param[in] cpus CPUs to pin the shards to, one shard per listed CPU
+        * @param[in] keyCallback Optional callback providing a custom dispatch key of a message
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void enableShardedDispatch(const std::vector<unsigned>& cpus, dispatch_key_callback keyCallback = {}) = 0;
+
+        /*!
+        * @brief Makes threads other than the processing loop thread hand their outgoing messages over to the loop
+        *
+        * Normally, a reply sent through @c Result::returnResults(), or a signal emitted from a worker
+        * or executor thread, is written to the bus socket right in that thread, under the bus lock
+        * that the processing loop thread holds while it processes incoming messages. With the outbound
+        * queue enabled, such threads only push the message into a lock-free queue and wake the loop up.
+        * The loop thread sends all queued messages in one go before it processes incoming messages.
+        * Messages from one thread are sent in the order in which they were pushed.
+        *
+        * Messages sent from the loop thread itself, or while the processing loop is not running,
+        * are still sent right away. Messages pushed while the loop is exiting are sent once it is
+        * entered again, or when the connection is destroyed.
+        *
+        * Must be called before the processing loop is entered.
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void enableOutboundQueue() = 0;
+
+        /*!
+        * @brief Makes proxies on the connection share one signal match rule per interface
+        *
+        * Normally, each signal handler registered by a proxy adds a match rule of its own to the bus
+        * daemon and to sd-bus, which matches every incoming signal against all of them in turn. With
+        * many proxies on one connection, both the rules and the matching add up. With demultiplexing
+        * enabled, handlers of signals of one interface share a single match rule, and the connection
+        * routes each received signal to the handlers of its object path, interface and name through
+        * a hash table lookup.
+        *
+        * The shared rule does not restrict the object path, so the bus daemon sends signals of the
+        * interface from all objects to the connection. Handlers with a @c SignalFilter that restricts
+        * arguments or a path namespace keep match rules of their own.
+        *
+        * Must be called before the processing loop is entered and before any proxy is created.
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void enableSignalDemultiplexing() = 0;
+
+        /*!
+        * @brief Holds back messages sent over the connection from the calling thread
+        *
+        * Replies, signals and no-reply method calls sent from the calling thread are held back
+        * until the matching @c uncork() call, which sends them all in one go. Other threads are
+        * not affected. Calls may be nested; the outermost @c uncork() sends the messages.
+        * Method calls that wait for a reply are not held back. Use @c sdbus::ScopedCork to pair
+        * the calls reliably.
+        *
+        * Sending a burst of messages, e.g. signals of a high-rate telemetry emitter, this way
+        * takes the bus lock and wakes up the processing loop once per burst instead of once
+        * per message.
+        */
+        virtual void cork() = 0;
+
+        /*!
+        * @brief Sends messages held back since the matching @c cork() call
+        *
+        * All held-back messages are sent even if sending some of them fails.
+        *
+        * @throws sdbus::Error in case the connection is not corked in the calling thread,
+        *         or if sending any of the messages failed
+        */
+        virtual void uncork() = 0;
+
+        /*!
+        * @brief Bounds the number of messages waiting in the connection to be written to the bus socket
+        *
+        * @param[in] maxMessages Maximum write queue depth, 0 for no limit
+        * @param[in] policy What to do with a message sent while the queue is full
+        *
+        * Messages pile up in the write queue when the peer, e.g. the bus daemon or a slow
+        * subscriber behind it, does not read them fast enough. Without a limit, the queue grows
+        * until sd-bus refuses further messages, hundreds of thousands of them later. The limit
+        * applies to replies, signals and no-reply method calls.
+        *
+        * With @c OverflowPolicy::eBlock, a sender other than the processing loop thread waits
+        * for the processing loop to drain the queue, while the processing loop thread itself,
+        * or any sender when the loop is not running, writes the queue out in place.
+        *
+        * Messages held back by @c cork() are not subject to the limit when uncorked.
+        * Must be called before the processing loop is entered.
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void setWriteQueueLimit(std::size_t maxMessages, OverflowPolicy policy) = 0;
+
+        /*!
+        * @brief Installs a handler notified when the write queue becomes congested, and when it recovers
+        *
+        * @param[in] lowWatermark Queue depth at or below which the queue is considered recovered
+        * @param[in] highWatermark Queue depth at or above which the queue is considered congested
+        * @param[in] handler Handler called with true upon congestion, and with false upon recovery
+        *
+        * The handler lets producers throttle themselves before the write queue limit is hit.
+        * Congestion is detected when a message is sent, so the handler is called in the sending
+        * thread; recovery is detected by the processing loop, in whose thread the handler is called.
+        *
+        * Must be called before the processing loop is entered.
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void setWriteQueueWatermarks(std::size_t lowWatermark, std::size_t highWatermark, watermark_handler handler) = 0;
+
+        /*!
+        * @brief Returns the number of messages waiting in the connection to be written to the bus socket
+        *
+        * The size of the queue in bytes is not available from sd-bus.
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual std::size_t getWriteQueueDepth() const = 0;
+
+        /*!
+        * @brief Sets the default timeout for method calls issued over the connection
+        *
+        * @param[in] timeout Timeout in microseconds (0 restores the sd-bus default of 25 seconds)
+        *
+        * Applies to method calls for which neither the call itself nor the proxy specifies a timeout.
+        * Requires libsystemd 240 or newer.
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void setMethodCallTimeout(uint64_t timeout) = 0;
+
+        /*!
+        * @copydoc IConnection::setMethodCallTimeout(uint64_t)
+        */
+        template <typename _Rep, typename _Period>
+        void setMethodCallTimeout(const std::chrono::duration<_Rep, _Period>& timeout);
+
+        /*!
+        * @brief Returns the default timeout for method calls issued over the connection
+        *
+        * @return Timeout in microseconds
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual uint64_t getMethodCallTimeout() const = 0;
+
+        /*!
+        * @brief Selects the mechanism the processing loop waits with
+        *
+        * With @a eIoUring, the bus socket and the internal loop descriptors are watched
+        * by multishot poll requests that stay armed across wakeups, so each wait takes
+        * a single io_uring_enter call. If io_uring is unavailable (old kernel, disabled
+        * by sysctl or seccomp policy), the connection silently stays with poll; use
+        * @getEventLoopBackend to find out the backend actually in use.
+        *
+        * Must be called before the processing loop is entered.
+        *
+        * @param[in] backend Requested backend
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void setEventLoopBackend(EventLoopBackend backend) = 0;
+
+        /*!
+        * @brief Returns the mechanism the processing loop waits with
+        *
+        * @return Backend in use
+        */
+        virtual EventLoopBackend getEventLoopBackend() const = 0;
+
         inline virtual ~IConnection() = 0;
     };
 
     IConnection::~IConnection() {}
 
+    template <typename _Rep, typename _Period>
+    inline void IConnection::setMethodCallTimeout(const std::chrono::duration<_Rep, _Period>& timeout)
+    {
+        auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(timeout);
+        setMethodCallTimeout(microsecs.count());
+    }
+
+    /********************************************//**
+     * @class ScopedCork
+     *
+     * Corks a connection, or the connection of an object, for the lifetime
+     * of the scope, see @c IConnection::cork(). Messages held back are sent
+     * when the scope is left; errors in sending them are ignored.
+     *
+     ***********************************************/
+    template <typename _Corkable>
+    class ScopedCork
+    {
+    public:
+        explicit ScopedCork(_Corkable& corkable)
+            : corkable_(corkable)
+        {
+            corkable_.cork();
+        }
+
+        ScopedCork(const ScopedCork&) = delete;
+        ScopedCork& operator=(const ScopedCork&) = delete;
+
+        ~ScopedCork()
+        {
+            try
+            {
+                corkable_.uncork();
+            }
+            catch (...)
+            {
+            }
+        }
+
+    private:
+        _Corkable& corkable_;
+    };
+
     /*!
     * @brief Creates/opens D-Bus system connection
     *
@@ -152,6 +518,52 @@ namespace sdbus {
     */
     std::unique_ptr<sdbus::IConnection> createSessionBusConnection(const std::string& name);
 
+    /*!
+    * @brief Creates/opens a direct peer-to-peer D-Bus connection to a given address
+    *
+    * No bus daemon is involved, messages go straight to the peer listening at @a address
+    * (e.g. "unix:path=/run/my-service.socket"). Objects and proxies are used as usual,
+    * except that proxies are created with an empty destination. Bus names cannot be
+    * requested on such a connection, and signals are delivered to the peer only.
+    *
+    * The authentication handshake completes in the processing loop or on first use.
+    *
+    * @param[in] address D-Bus address of the peer, in the sd-bus address format
+    * @return Connection instance
+    *
+    * @throws sdbus::Error in case of failure
+    */
+    std::unique_ptr<sdbus::IConnection> createDirectConnection(const std::string& address);
+
+    /*!
+    * @brief Creates a direct peer-to-peer D-Bus connection over an already connected socket
+    *
+    * The same as @createDirectConnection(const std::string&), but over an existing socket
+    * connected to the peer (e.g. one end of a socketpair). The connection takes ownership
+    * of @a fd and closes it when destroyed, or right away if it fails to be created.
+    *
+    * @param[in] fd Connected socket
+    * @return Connection instance
+    *
+    * @throws sdbus::Error in case of failure
+    */
+    std::unique_ptr<sdbus::IConnection> createDirectConnection(int fd);
+
+    /*!
+    * @brief Creates the server side of a direct peer-to-peer D-Bus connection
+    *
+    * To be called with each socket accepted on a listening socket of the server (or with
+    * the other end of a socketpair). The connection authenticates the client, then serves
+    * its objects to it. The connection takes ownership of @a fd and closes it when destroyed,
+    * or right away if it fails to be created.
+    *
+    * @param[in] fd Accepted socket
+    * @return Connection instance
+    *
+    * @throws sdbus::Error in case of failure
+    */
+    std::unique_ptr<sdbus::IConnection> createServerConnection(int fd);
+
 }
 
 #endif /* SDBUS_CXX_ICONNECTION_H_ */
@@ -0,0 +1,83 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file IConnectionPool.h
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_ICONNECTIONPOOL_H_
+#define SDBUS_CXX_ICONNECTIONPOOL_H_
+
+#include <memory>
+#include <cstddef>
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class IConnectionPool
+     *
+     * A set of D-Bus bus connections, each with its own processing loop
+     * running in an internal thread, over which object proxies spread their
+     * method calls. One connection is one socket, through which all calls,
+     * replies and signals pass one after another; a pool of connections lets
+     * a client process have more calls in flight at the same time.
+     *
+     * The pool must outlive all object proxies created upon it.
+     *
+     ***********************************************/
+    class IConnectionPool
+    {
+    public:
+        /*!
+        * @brief How a proxy created upon the pool spreads its method calls over the pool connections
+        */
+        enum class CallDistribution
+        {
+            eRoundRobin,    //!< Each call goes over the next connection; calls may overtake each other
+            ePerObject      //!< All calls to an object go over the same connection, in the order they are issued
+        };
+
+        /*!
+        * @brief Returns the number of connections in the pool
+        */
+        virtual std::size_t getSize() const = 0;
+
+        inline virtual ~IConnectionPool() = 0;
+    };
+
+    IConnectionPool::~IConnectionPool() {}
+
+    /*!
+    * @brief Creates a pool of D-Bus system bus connections
+    *
+    * @param[in] size Number of connections in the pool
+    * @return Connection pool instance
+    *
+    * Each connection in the pool is opened and its processing loop is started
+    * in a separate internal thread right away.
+    *
+    * @throws sdbus::Error in case of failure
+    */
+    std::unique_ptr<sdbus::IConnectionPool> createConnectionPool(std::size_t size);
+
+}
+
+#endif /* SDBUS_CXX_ICONNECTIONPOOL_H_ */
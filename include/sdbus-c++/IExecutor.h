@@ -0,0 +1,92 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file IExecutor.h
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_IEXECUTOR_H_
+#define SDBUS_CXX_IEXECUTOR_H_
+
+#include <functional>
+#include <memory>
+#include <cstddef>
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class IExecutor
+     *
+     * An executor runs tasks handed over to it, typically in threads of its own.
+     * D-Bus methods can be set to be executed on an executor, so that their handlers
+     * run off the connection's processing loop thread, and a slow handler does not hold
+     * back other incoming calls and signals. Any class implementing this interface
+     * can serve as an executor; sdbus-c++ provides a thread pool implementation
+     * through @c createThreadPool().
+     *
+     * The executor must outlive all objects whose methods are executed on it.
+     *
+     ***********************************************/
+    class IExecutor
+    {
+    public:
+        /*!
+        * @brief Runs the given task, at some point, in some thread of the executor
+        *
+        * @param[in] task Task to run
+        *
+        * The method must be thread-safe, it may be called from any thread,
+        * including threads of the executor itself.
+        *
+        * The task is not supposed to throw. Tasks handed over by sdbus-c++ handle
+        * their failures themselves, e.g. a method call job turns any exception of
+        * the method handler into an error reply.
+        */
+        virtual void execute(std::function<void()> task) = 0;
+
+        inline virtual ~IExecutor() = 0;
+    };
+
+    IExecutor::~IExecutor() {}
+
+    /*!
+    * @brief Creates a work-stealing thread pool executor
+    *
+    * @param[in] threadCount Number of threads in the pool, 0 for one thread per available CPU
+    * @return Executor instance
+    *
+    * Each thread of the pool has its own queues of tasks. Tasks submitted from
+    * outside the pool are spread over the threads round-robin and run in the order
+    * of submission; tasks submitted from a pool thread stay with that thread and run
+    * most recent first, ahead of the submitted ones. A thread that runs out of tasks
+    * steals the oldest tasks of other threads, so a few long tasks do not starve
+    * the rest of the work behind them.
+    *
+    * Tasks still queued when the pool is destroyed are run before the destructor returns.
+    * An exception escaping a task is swallowed; the thread goes on with further tasks.
+    *
+    * @throws sdbus::Error in case of failure
+    */
+    std::unique_ptr<sdbus::IExecutor> createThreadPool(std::size_t threadCount = 0);
+
+}
+
+#endif /* SDBUS_CXX_IEXECUTOR_H_ */
@@ -32,11 +32,14 @@
 #include <functional>
 #include <string>
 #include <memory>
+#include <chrono>
+#include <cstdint>
 
 // Forward declarations
 namespace sdbus {
     class Signal;
     class IConnection;
+    class IExecutor;
 }
 
 namespace sdbus {
@@ -155,6 +158,106 @@ namespace sdbus {
         */
         virtual void setInterfaceFlags(const std::string& interfaceName, Flags flags) = 0;
 
+        /*!
+        * @brief Sets how long method calls of a given interface may wait before being handled
+        *
+        * @param[in] interfaceName Name of an interface
+        * @param[in] maxQueueAge Maximum age of a method call in microseconds, 0 for no limit
+        *
+        * A method call that has been waiting longer than @p maxQueueAge by the time its handler
+        * would be invoked is dropped silently, without a reply, and counted in
+        * @c getExpiredMethodCallCount(). Its caller has typically timed out and given up on
+        * the reply already, so handling it would only waste time of an already overloaded
+        * service. The age is measured from the receive timestamp of the call, if the bus
+        * provides one, otherwise from the moment the connection read the call from the bus.
+        *
+        * Calls only wait for dispatch workers or method executors; the processing loop thread
+        * itself handles a call right after reading it. A limit on methods that have neither
+        * makes @c finishRegistration() fail, so enable multi-threaded dispatch on the connection
+        * or set a method executor first.
+        *
+        * Must be called before @c finishRegistration().
+        *
+        * @throws sdbus::Error in case of failure, or if called after @c finishRegistration()
+        */
+        virtual void setMaxMethodCallQueueAge(const std::string& interfaceName, uint64_t maxQueueAge) = 0;
+
+        /*!
+        * @brief Sets how long calls of a given method may wait before being handled
+        *
+        * @param[in] interfaceName Name of an interface that the method belongs to
+        * @param[in] methodName Name of the method
+        * @param[in] maxQueueAge Maximum age of a method call in microseconds, 0 for no limit
+        *
+        * Overrides the interface-wide setting for this one method.
+        * See @c setMaxMethodCallQueueAge(const std::string&, uint64_t) for details.
+        *
+        * @throws sdbus::Error in case of failure, or if called after @c finishRegistration()
+        */
+        virtual void setMaxMethodCallQueueAge( const std::string& interfaceName
+                                             , const std::string& methodName
+                                             , uint64_t maxQueueAge ) = 0;
+
+        /*!
+        * @copydoc IObject::setMaxMethodCallQueueAge(const std::string&,uint64_t)
+        */
+        template <typename _Rep, typename _Period>
+        void setMaxMethodCallQueueAge( const std::string& interfaceName
+                                     , const std::chrono::duration<_Rep, _Period>& maxQueueAge );
+
+        /*!
+        * @copydoc IObject::setMaxMethodCallQueueAge(const std::string&,const std::string&,uint64_t)
+        */
+        template <typename _Rep, typename _Period>
+        void setMaxMethodCallQueueAge( const std::string& interfaceName
+                                     , const std::string& methodName
+                                     , const std::chrono::duration<_Rep, _Period>& maxQueueAge );
+
+        /*!
+        * @brief Returns the number of method calls dropped because they waited too long
+        *
+        * @return Number of expired method calls dropped by this object so far
+        */
+        virtual uint64_t getExpiredMethodCallCount() const = 0;
+
+        /*!
+        * @brief Sets an executor that handlers of methods of a given interface run on
+        *
+        * @param[in] interfaceName Name of an interface
+        * @param[in] executor Executor to run the method handlers on
+        *
+        * Handlers of the interface methods are handed over to the executor instead of
+        * being invoked in the connection's processing loop thread (or in its dispatch workers,
+        * see @c IConnection::enableMultithreadedDispatch()). The loop thread thus only decodes
+        * the call header and moves on to the next incoming message. This works for all kinds
+        * of method handlers: synchronous, asynchronous and coroutine ones. Replies and errors
+        * are sent from the executor thread once the handler is done.
+        *
+        * The object waits upon its destruction for the handlers queued or running on executors,
+        * so it must not be destroyed from within such a handler, nor with the executor stopped.
+        *
+        * The executor must outlive the object. Must be called before @c finishRegistration().
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void setMethodExecutor(const std::string& interfaceName, IExecutor& executor) = 0;
+
+        /*!
+        * @brief Sets an executor that the handler of a given method runs on
+        *
+        * @param[in] interfaceName Name of an interface that the method belongs to
+        * @param[in] methodName Name of the method
+        * @param[in] executor Executor to run the method handler on
+        *
+        * Overrides the interface-wide setting for this one method.
+        * See @c setMethodExecutor(const std::string&, IExecutor&) for details.
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void setMethodExecutor( const std::string& interfaceName
+                                      , const std::string& methodName
+                                      , IExecutor& executor ) = 0;
+
         /*!
         * @brief Finishes the registration and exports object API on D-Bus
         *
@@ -191,6 +294,22 @@ namespace sdbus {
         */
         virtual void emitSignal(const sdbus::Signal& message) = 0;
 
+        /*!
+        * @brief Holds back signals emitted from the calling thread over the object's connection
+        *
+        * See @c IConnection::cork(). Applies to the whole connection of the object.
+        */
+        virtual void cork() = 0;
+
+        /*!
+        * @brief Sends signals held back since the matching @c cork() call
+        *
+        * See @c IConnection::uncork().
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void uncork() = 0;
+
         /*!
         * @brief Registers method that the object will provide on D-Bus
         *
@@ -290,6 +409,23 @@ namespace sdbus {
         virtual ~IObject() = 0;
     };
 
+    template <typename _Rep, typename _Period>
+    inline void IObject::setMaxMethodCallQueueAge( const std::string& interfaceName
+                                                 , const std::chrono::duration<_Rep, _Period>& maxQueueAge )
+    {
+        auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(maxQueueAge);
+        setMaxMethodCallQueueAge(interfaceName, microsecs.count());
+    }
+
+    template <typename _Rep, typename _Period>
+    inline void IObject::setMaxMethodCallQueueAge( const std::string& interfaceName
+                                                 , const std::string& methodName
+                                                 , const std::chrono::duration<_Rep, _Period>& maxQueueAge )
+    {
+        auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(maxQueueAge);
+        setMaxMethodCallQueueAge(interfaceName, methodName, microsecs.count());
+    }
+
     inline MethodRegistrator IObject::registerMethod(const std::string& methodName)
     {
         return MethodRegistrator(*this, methodName);
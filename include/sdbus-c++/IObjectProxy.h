@@ -27,9 +27,12 @@
 #define SDBUS_CXX_IOBJECTPROXY_H_
 
 #include <sdbus-c++/ConvenienceClasses.h>
+#include <sdbus-c++/IConnectionPool.h>
 #include <string>
 #include <memory>
 #include <functional>
+#include <chrono>
+#include <cstdint>
 
 // Forward declarations
 namespace sdbus {
@@ -37,10 +40,56 @@ namespace sdbus {
     class AsyncMethodCall;
     class MethodReply;
     class IConnection;
+    namespace internal {
+        class ObjectProxy;
+    }
 }
 
 namespace sdbus {
 
+    /********************************************//**
+     * @class PendingAsyncCall
+     *
+     * Handle to an asynchronous method call that is in progress,
+     * as returned by the async overload of @c IObjectProxy::callMethod().
+     *
+     * The handle does not keep the call alive; it merely refers to it.
+     * Once the reply arrives, the call times out, the call is cancelled,
+     * or its proxy is destroyed, the handle becomes stale and calling
+     * @c cancel() on it is a no-op. A default-constructed handle refers
+     * to no call.
+     *
+     ***********************************************/
+    class PendingAsyncCall
+    {
+    public:
+        PendingAsyncCall() = default;
+
+        /*!
+        * @brief Cancels the call, if it is still pending
+        *
+        * The reply handler of a cancelled call is never invoked, and a reply
+        * that arrives later is discarded. Cancelling is thread-safe; if the
+        * reply handler is running at the moment, the call is no longer
+        * considered pending and nothing happens.
+        */
+        void cancel();
+
+        /*!
+        * @brief Tells whether the call is still waiting for its reply
+        *
+        * @return True if the reply has neither arrived nor timed out, and the call has not been cancelled
+        */
+        bool isPending() const;
+
+    private:
+        friend internal::ObjectProxy;
+        PendingAsyncCall(std::weak_ptr<void> callData);
+
+    private:
+        std::weak_ptr<void> callData_;
+    };
+
     /********************************************//**
      * @class IObjectProxy
      *
@@ -54,6 +103,15 @@ namespace sdbus {
     class IObjectProxy
     {
     public:
+        /*!
+        * @brief When the proxy subscribes to the signals it has handlers for at the bus daemon
+        */
+        enum class SignalSubscription
+        {
+            eEager, //!< All signal handlers are enabled by finishRegistration() (default)
+            eLazy   //!< A signal handler is enabled only by enableSignalHandler()
+        };
+
         /*!
         * @brief Creates a method call message
         *
@@ -88,10 +146,11 @@ namespace sdbus {
         * @brief Calls method on the proxied D-Bus object
         *
         * @param[in] message Message representing a method call
+        * @param[in] timeout Method call timeout in microseconds (0 for the proxy default)
         * @return A method reply message
         *
         * Normally, the call is blocking, i.e. it waits for the remote method to finish with either
-        * a return value or an error.
+        * a return value or an error, at most @a timeout long.
         *
         * If the method call argument is set to not expect reply, the call will not wait for the remote
         * method to finish, i.e. the call will be non-blocking, and the function will return an empty,
@@ -101,23 +160,45 @@ namespace sdbus {
         *
         * @throws sdbus::Error in case of failure
         */
-        virtual MethodReply callMethod(const MethodCall& message) = 0;
+        virtual MethodReply callMethod(const MethodCall& message, uint64_t timeout = 0) = 0;
 
         /*!
         * @brief Calls method on the proxied D-Bus object asynchronously
         *
         * @param[in] message Message representing an async method call
         * @param[in] asyncReplyHandler Handler for the async reply
+        * @param[in] timeout Method call timeout in microseconds (0 for the proxy default)
+        *
+        * @return Handle to the pending call, which can be used to cancel it
         *
         * The call is non-blocking. It doesn't wait for the reply. Once the reply arrives,
-        * the provided async reply handler will get invoked from the context of the connection
-        * event loop processing thread.
+        * or the timeout elapses, the provided async reply handler will get invoked from
+        * the context of the connection event loop processing thread. Unless the call is
+        * cancelled in the meantime, or the proxy is destroyed, which cancels all its pending
+        * calls; the handler is then never invoked.
         *
         * Note: To avoid messing with messages, use higher-level API defined below.
         *
         * @throws sdbus::Error in case of failure
         */
-        virtual void callMethod(const AsyncMethodCall& message, async_reply_handler asyncReplyCallback) = 0;
+        virtual PendingAsyncCall callMethod(const AsyncMethodCall& message, async_reply_handler asyncReplyCallback, uint64_t timeout = 0) = 0;
+
+        /*!
+        * @brief Sets the default timeout for method calls issued through this proxy
+        *
+        * @param[in] timeout Timeout in microseconds
+        *
+        * Applies to calls that do not specify their own timeout. If not set, or set to 0, the
+        * method call timeout of the connection is used (see @c IConnection::setMethodCallTimeout),
+        * which defaults to 25 seconds.
+        */
+        virtual void setMethodCallTimeout(uint64_t timeout) = 0;
+
+        /*!
+        * @copydoc IObjectProxy::setMethodCallTimeout(uint64_t)
+        */
+        template <typename _Rep, typename _Period>
+        void setMethodCallTimeout(const std::chrono::duration<_Rep, _Period>& timeout);
 
         /*!
         * @brief Registers a handler for the desired signal emitted by the proxied D-Bus object
@@ -132,16 +213,81 @@ namespace sdbus {
                                           , const std::string& signalName
                                           , signal_handler signalHandler ) = 0;
 
+        /*!
+        * @brief Registers a handler for the desired signal, filtered by the bus daemon
+        *
+        * @param[in] interfaceName Name of an interface that the signal belongs to
+        * @param[in] signalName Name of the signal
+        * @param[in] filter Predicates on the signal arguments and object path
+        * @param[in] signalHandler Callback that implements the body of the signal handler
+        *
+        * The predicates are added to the match rule of the signal, so only signals that
+        * pass them are sent to us at all.
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void registerSignalHandler( const std::string& interfaceName
+                                          , const std::string& signalName
+                                          , const SignalFilter& filter
+                                          , signal_handler signalHandler ) = 0;
+
         /*!
         * @brief Finishes the registration of signal handlers
         *
-        * The method physically subscribes to the desired signals.
+        * The method physically subscribes to the desired signals, unless the signal
+        * subscription is lazy. All the match rules are sent to the bus daemon at once,
+        * and the method waits for them in one round trip. (Called from within a message
+        * handler, where the connection cannot be processed, it waits for each rule in turn.)
+        * Without a running processing loop, messages received so far get dispatched
+        * in the calling thread, along with the replies to the match rules.
         * Must be called only once, after all signals have been registered already.
         *
         * @throws sdbus::Error in case of failure
         */
         virtual void finishRegistration() = 0;
 
+        /*!
+        * @brief Sets when the proxy subscribes to the signals it has handlers for
+        *
+        * @param[in] subscription Eager (default) or lazy signal subscription
+        *
+        * With lazy subscription, no match rule is added to the bus daemon for a signal
+        * until its handler is enabled by @c enableSignalHandler(). The daemon then neither
+        * forwards signals the application does not react to, nor wakes us up for them.
+        *
+        * Must be called before @c finishRegistration().
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void setSignalSubscription(SignalSubscription subscription) = 0;
+
+        /*!
+        * @brief Subscribes to a signal whose handler has been registered
+        *
+        * @param[in] interfaceName Name of an interface that the signal belongs to
+        * @param[in] signalName Name of the signal
+        *
+        * Adds the match rule for the signal and waits for the bus daemon to install it,
+        * so the handler receives any signal emitted once the method returns. Enabling
+        * an enabled handler is a no-op. May only be called after @c finishRegistration().
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void enableSignalHandler(const std::string& interfaceName, const std::string& signalName) = 0;
+
+        /*!
+        * @brief Unsubscribes from a signal whose handler has been registered
+        *
+        * @param[in] interfaceName Name of an interface that the signal belongs to
+        * @param[in] signalName Name of the signal
+        *
+        * Removes the match rule for the signal; the handler stays registered and may be
+        * enabled again. Disabling a disabled handler is a no-op.
+        *
+        * @throws sdbus::Error in case of failure
+        */
+        virtual void disableSignalHandler(const std::string& interfaceName, const std::string& signalName) = 0;
+
         /*!
         * @brief Calls method on the proxied D-Bus object
         *
@@ -203,6 +349,11 @@ namespace sdbus {
         * object_.uponSignal("fooSignal").onInterface("com.kistler.foo").call([this](int arg1, double arg2){ this->onFooSignal(arg1, arg2); });
         * @endcode
         *
+        * Signals may be filtered by the bus daemon already, based on their arguments:
+        * @code
+        * object_.uponSignal("deviceChanged").onInterface("com.kistler.foo").whereArgument(0, "dev7").call([this](const std::string& id, int state){ ... });
+        * @endcode
+        *
         * @throws sdbus::Error in case of failure
         */
         SignalSubscriber uponSignal(const std::string& signalName);
@@ -248,6 +399,13 @@ namespace sdbus {
         virtual ~IObjectProxy() = 0;
     };
 
+    template <typename _Rep, typename _Period>
+    inline void IObjectProxy::setMethodCallTimeout(const std::chrono::duration<_Rep, _Period>& timeout)
+    {
+        auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(timeout);
+        setMethodCallTimeout(microsecs.count());
+    }
+
     inline MethodInvoker IObjectProxy::callMethod(const std::string& methodName)
     {
         return MethodInvoker(*this, methodName);
@@ -324,25 +482,55 @@ namespace sdbus {
                                                           , std::string objectPath );
 
     /*!
-    * @brief Creates object proxy instance that uses its own D-Bus connection
+    * @brief Creates object proxy instance that uses a process-wide shared D-Bus connection
     *
     * @param[in] destination Bus name that provides a D-Bus object
     * @param[in] objectPath Path of the D-Bus object
     * @return Pointer to the object proxy instance
     *
-    * This factory overload creates a proxy that manages its own D-Bus connection(s).
-    * When there is at least one signal in proxy's interface, then the proxy will immediately
-    * start its own processing loop for this connection in its own separate thread, causing
-    * incoming signals to be correctly received and processed in the context of that thread.
+    * This factory overload creates a proxy upon a system bus connection shared by all proxies
+    * created this way. The connection is opened, and its processing loop is started in an internal
+    * thread, with the first such proxy; it is closed when the last one is destroyed. Creating
+    * further proxies thus costs neither a new connection handshake nor a new thread. Signals
+    * and async replies of all these proxies are processed in the context of that single thread.
     *
     * Code example:
     * @code
-    * auto proxy = sdbus::createObjectProxy(connection, "com.kistler.foo", "/com/kistler/foo");
+    * auto proxy = sdbus::createObjectProxy("com.kistler.foo", "/com/kistler/foo");
     * @endcode
     */
     std::unique_ptr<sdbus::IObjectProxy> createObjectProxy( std::string destination
                                                           , std::string objectPath );
 
+    /*!
+    * @brief Creates object proxy instance that spreads its method calls over a connection pool
+    *
+    * @param[in] pool Connection pool to be used by the proxy object
+    * @param[in] destination Bus name that provides a D-Bus object
+    * @param[in] objectPath Path of the D-Bus object
+    * @param[in] distribution How the method calls are spread over the pool connections
+    * @return Pointer to the object proxy instance
+    *
+    * With @c eRoundRobin distribution, each method call, synchronous or asynchronous, goes over
+    * the next connection of the pool, so calls issued from many threads are processed in parallel
+    * but may overtake each other. With @c ePerObject distribution, all calls of the proxy go over
+    * one connection chosen by the object path, so they arrive in the order they have been issued.
+    * Signals are always subscribed to on that one connection. Async replies and signals are
+    * handled in the processing loop thread of the respective pool connection.
+    *
+    * The pool must outlive the proxy.
+    *
+    * Code example:
+    * @code
+    * auto pool = sdbus::createConnectionPool(4);
+    * auto proxy = sdbus::createObjectProxy(*pool, "com.kistler.foo", "/com/kistler/foo");
+    * @endcode
+    */
+    std::unique_ptr<sdbus::IObjectProxy> createObjectProxy( sdbus::IConnectionPool& pool
+                                                          , std::string destination
+                                                          , std::string objectPath
+                                                          , IConnectionPool::CallDistribution distribution = IConnectionPool::CallDistribution::eRoundRobin );
+
 }
 
 #include <sdbus-c++/ConvenienceClasses.inl>
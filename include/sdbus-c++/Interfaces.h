@@ -35,6 +35,7 @@
 // Forward declarations
 namespace sdbus {
     class IConnection;
+    class IExecutor;
 }
 
 namespace sdbus {
@@ -70,6 +71,8 @@ namespace sdbus {
      * A helper template class that a user class representing a D-Bus object
      * should inherit from, providing as template arguments the adaptor
      * classes representing D-Bus interfaces that the object implements.
+     * If constructed with an executor, methods annotated for execution
+     * on an executor in the interface description run on that executor.
      *
      ***********************************************/
     template <typename... _Interfaces>
@@ -84,6 +87,13 @@ namespace sdbus {
         {
             getObject().finishRegistration();
         }
+
+        Interfaces(IConnection& connection, std::string objectPath, IExecutor& executor)
+            : ObjectHolder<IObject>(createObject(connection, std::move(objectPath)))
+            , _Interfaces(getObject(), &executor)...
+        {
+            getObject().finishRegistration();
+        }
     };
 
     /********************************************//**
@@ -106,7 +116,7 @@ namespace sdbus {
         * @param[in] destination Bus name that provides a D-Bus object
         * @param[in] objectPath Path of the D-Bus object
         *
-        * This constructor overload creates a proxy that manages its own D-Bus connection(s).
+        * This constructor overload creates a proxy upon a process-wide shared D-Bus connection.
         * For more information on its behavior, consult @ref createObjectProxy(std::string, std::string)
         */
         ProxyInterfaces(std::string destination, std::string objectPath)
@@ -133,6 +143,28 @@ namespace sdbus {
             getObject().finishRegistration();
         }
 
+        /*!
+        * @brief Creates fully working object proxy instance with the given signal subscription
+        *
+        * @param[in] connection D-Bus connection to be used by the proxy object
+        * @param[in] destination Bus name that provides a D-Bus object
+        * @param[in] objectPath Path of the D-Bus object
+        * @param[in] subscription Eager or lazy subscription to the signals of the interfaces
+        *
+        * With lazy subscription, signal handlers of the interfaces are enabled by the user
+        * class via @c getProxy().enableSignalHandler().
+        */
+        ProxyInterfaces( IConnection& connection
+                       , std::string destination
+                       , std::string objectPath
+                       , IObjectProxy::SignalSubscription subscription )
+            : ObjectHolder<IObjectProxy>(createObjectProxy(connection, std::move(destination), std::move(objectPath)))
+            , _Interfaces(getObject())...
+        {
+            getObject().setSignalSubscription(subscription);
+            getObject().finishRegistration();
+        }
+
         /*!
         * @brief Creates fully working object proxy instance
         *
@@ -149,6 +181,33 @@ namespace sdbus {
         {
             getObject().finishRegistration();
         }
+
+        /*!
+        * @brief Creates fully working object proxy instance
+        *
+        * @param[in] pool Connection pool to be used by the proxy object
+        * @param[in] destination Bus name that provides a D-Bus object
+        * @param[in] objectPath Path of the D-Bus object
+        * @param[in] distribution How the method calls are spread over the pool connections
+        *
+        * The proxy spreads its method calls over connections of the pool.
+        * For more information, consult @ref createObjectProxy(sdbus::IConnectionPool&,std::string,std::string,IConnectionPool::CallDistribution)
+        */
+        ProxyInterfaces( IConnectionPool& pool
+                       , std::string destination
+                       , std::string objectPath
+                       , IConnectionPool::CallDistribution distribution = IConnectionPool::CallDistribution::eRoundRobin )
+            : ObjectHolder<IObjectProxy>(createObjectProxy(pool, std::move(destination), std::move(objectPath), distribution))
+            , _Interfaces(getObject())...
+        {
+            getObject().finishRegistration();
+        }
+
+    protected:
+        IObjectProxy& getProxy()
+        {
+            return getObject();
+        }
     };
 
 }
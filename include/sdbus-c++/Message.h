@@ -53,6 +53,7 @@ namespace sdbus {
 
     namespace internal {
         class ISdBus;
+        ISdBus* getSdBusInterfaceOf(const Message& message) noexcept;
     }
 }
 
@@ -124,28 +125,43 @@ namespace sdbus {
         Message& operator>>(Signature &item);
 
         Message& openContainer(const std::string& signature);
+        Message& openContainer(const char* signature);
         Message& closeContainer();
         Message& openDictEntry(const std::string& signature);
+        Message& openDictEntry(const char* signature);
         Message& closeDictEntry();
         Message& openVariant(const std::string& signature);
+        Message& openVariant(const char* signature);
         Message& closeVariant();
         Message& openStruct(const std::string& signature);
+        Message& openStruct(const char* signature);
         Message& closeStruct();
 
         Message& enterContainer(const std::string& signature);
+        Message& enterContainer(const char* signature);
         Message& exitContainer();
         Message& enterDictEntry(const std::string& signature);
+        Message& enterDictEntry(const char* signature);
         Message& exitDictEntry();
         Message& enterVariant(const std::string& signature);
+        Message& enterVariant(const char* signature);
         Message& exitVariant();
         Message& enterStruct(const std::string& signature);
+        Message& enterStruct(const char* signature);
         Message& exitStruct();
 
+        // Appends an array of a fixed-size basic type (e.g. 'y', 'i', 'd') as one block
+        Message& appendArray(char type, const void* ptr, std::size_t size);
+        // Reads an array of a fixed-size basic type as one block, pointing into the message. Returns
+        // false, with nothing read, if the message is in foreign byte order and needs reading elementwise.
+        bool readArray(char type, const void*& ptr, std::size_t& size);
+
         operator bool() const;
         void clearFlags();
 
         std::string getInterfaceName() const;
         std::string getMemberName() const;
+        std::string getPath() const;
         void peekType(std::string& type, std::string& contents) const;
         bool isValid() const;
         bool isEmpty() const;
@@ -155,8 +171,13 @@ namespace sdbus {
         void rewind(bool complete);
 
     protected:
+        friend internal::ISdBus* internal::getSdBusInterfaceOf(const Message& message) noexcept;
+
         void* msg_{};
         internal::ISdBus* sdbus_{};
+        // Holds the one sd-bus reference shared by all copies of this message. Copying
+        // a message thus only touches an atomic counter, never the underlying bus.
+        std::shared_ptr<void> msgRef_;
         mutable bool ok_{true};
     };
 
@@ -164,14 +185,14 @@ namespace sdbus {
     {
     public:
         using Message::Message;
-        MethodReply send() const;
+        MethodReply send(uint64_t timeout = 0) const;
         MethodReply createReply() const;
         MethodReply createErrorReply(const sdbus::Error& error) const;
         void dontExpectReply();
         bool doesntExpectReply() const;
 
     private:
-        MethodReply sendWithReply() const;
+        MethodReply sendWithReply(uint64_t timeout) const;
         MethodReply sendWithNoReply() const;
     };
 
@@ -181,7 +202,7 @@ namespace sdbus {
         using Message::Message;
         AsyncMethodCall() = default; // Fixes gcc 6.3 error (default c-tor is not imported in above using declaration)
         AsyncMethodCall(MethodCall&& call) noexcept;
-        void send(void* callback, void* userData) const;
+        void send(void* callback, void* userData, uint64_t timeout = 0, void** slot = nullptr) const;
     };
 
     class MethodReply : public Message
@@ -201,7 +222,12 @@ namespace sdbus {
     template <typename _Element>
     inline Message& operator<<(Message& msg, const std::vector<_Element>& items)
     {
-        msg.openContainer(signature_of<_Element>::str());
+        if constexpr (is_trivial_dbus_type_v<_Element>)
+        {
+            return msg.appendArray(signature_of_v<_Element>.c_str()[0], items.data(), items.size() * sizeof(_Element));
+        }
+
+        msg.openContainer(signature_of_v<_Element>.c_str());
 
         for (const auto& item : items)
             msg << item;
@@ -214,8 +240,9 @@ namespace sdbus {
     template <typename _Key, typename _Value>
     inline Message& operator<<(Message& msg, const std::map<_Key, _Value>& items)
     {
-        const std::string dictEntrySignature = signature_of<_Key>::str() + signature_of<_Value>::str();
-        const std::string arraySignature = "{" + dictEntrySignature + "}";
+        // Array element signature is the dictionary entry in braces, i.e. the map signature without the leading 'a'
+        const auto* arraySignature = signature_of_v<std::map<_Key, _Value>>.c_str() + 1;
+        const auto* dictEntrySignature = detail::dict_entry_signature_v<_Key, _Value>.c_str();
 
         msg.openContainer(arraySignature);
 
@@ -255,10 +282,7 @@ namespace sdbus {
     template <typename... _ValueTypes>
     inline Message& operator<<(Message& msg, const Struct<_ValueTypes...>& item)
     {
-        auto structSignature = signature_of<Struct<_ValueTypes...>>::str();
-        assert(structSignature.size() > 2);
-        // Remove opening and closing parenthesis from the struct signature to get contents signature
-        auto structContentSignature = structSignature.substr(1, structSignature.size()-2);
+        const auto* structContentSignature = detail::struct_content_signature_v<_ValueTypes...>.c_str();
 
         msg.openStruct(structContentSignature);
         detail::serialize_tuple(msg, item, std::index_sequence_for<_ValueTypes...>{});
@@ -278,7 +302,22 @@ namespace sdbus {
     template <typename _Element>
     inline Message& operator>>(Message& msg, std::vector<_Element>& items)
     {
-        if(!msg.enterContainer(signature_of<_Element>::str()))
+        if constexpr (is_trivial_dbus_type_v<_Element>)
+        {
+            const void* ptr{};
+            std::size_t size{};
+            if (msg.readArray(signature_of_v<_Element>.c_str()[0], ptr, size))
+            {
+                if (msg)
+                {
+                    const auto* elements = static_cast<const _Element*>(ptr);
+                    items.insert(items.end(), elements, elements + size / sizeof(_Element));
+                }
+                return msg;
+            }
+        }
+
+        if(!msg.enterContainer(signature_of_v<_Element>.c_str()))
             return msg;
 
         while (true)
@@ -300,8 +339,9 @@ namespace sdbus {
     template <typename _Key, typename _Value>
     inline Message& operator>>(Message& msg, std::map<_Key, _Value>& items)
     {
-        const std::string dictEntrySignature = signature_of<_Key>::str() + signature_of<_Value>::str();
-        const std::string arraySignature = "{" + dictEntrySignature + "}";
+        // Array element signature is the dictionary entry in braces, i.e. the map signature without the leading 'a'
+        const auto* arraySignature = signature_of_v<std::map<_Key, _Value>>.c_str() + 1;
+        const auto* dictEntrySignature = detail::dict_entry_signature_v<_Key, _Value>.c_str();
 
         if (!msg.enterContainer(arraySignature))
             return msg;
@@ -350,9 +390,7 @@ namespace sdbus {
     template <typename... _ValueTypes>
     inline Message& operator>>(Message& msg, Struct<_ValueTypes...>& item)
     {
-        auto structSignature = signature_of<Struct<_ValueTypes...>>::str();
-        // Remove opening and closing parenthesis from the struct signature to get contents signature
-        auto structContentSignature = structSignature.substr(1, structSignature.size()-2);
+        const auto* structContentSignature = detail::struct_content_signature_v<_ValueTypes...>.c_str();
 
         if (!msg.enterStruct(structContentSignature))
             return msg;
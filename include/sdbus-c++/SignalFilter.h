@@ -0,0 +1,103 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file SignalFilter.h
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_SIGNALFILTER_H_
+#define SDBUS_CXX_SIGNALFILTER_H_
+
+#include <string>
+#include <map>
+
+namespace sdbus {
+
+    /********************************************//**
+     * @class SignalFilter
+     *
+     * Predicates on the arguments and the object path of a signal.
+     * They become part of the match rule of the signal subscription,
+     * so the bus daemon drops signals that fail them, instead of
+     * forwarding them to the proxy to be filtered after deserialization.
+     *
+     ***********************************************/
+    class SignalFilter
+    {
+    public:
+        // Arguments beyond this index cannot be matched, per the D-Bus specification
+        static constexpr unsigned MAX_ARGUMENT_INDEX = 63;
+
+        // argN: the N-th argument is a string equal to the value
+        void setArgument(unsigned index, std::string value)
+        {
+            arguments_[index] = std::move(value);
+        }
+
+        // argNpath: the N-th argument is a string or object path equal to the path,
+        // or either of them is a prefix of the other one ending with a slash
+        void setArgumentPath(unsigned index, std::string path)
+        {
+            argumentPaths_[index] = std::move(path);
+        }
+
+        // arg0namespace: the first argument is a bus or interface name in the namespace
+        void setArgument0Namespace(std::string nameSpace)
+        {
+            argument0Namespace_ = std::move(nameSpace);
+        }
+
+        // path_namespace: the signal comes from the proxied object or from any object below it
+        void setPathNamespace(bool value = true)
+        {
+            pathNamespace_ = value;
+        }
+
+        const std::map<unsigned, std::string>& getArguments() const
+        {
+            return arguments_;
+        }
+
+        const std::map<unsigned, std::string>& getArgumentPaths() const
+        {
+            return argumentPaths_;
+        }
+
+        const std::string& getArgument0Namespace() const
+        {
+            return argument0Namespace_;
+        }
+
+        bool isPathNamespace() const
+        {
+            return pathNamespace_;
+        }
+
+    private:
+        std::map<unsigned, std::string> arguments_;
+        std::map<unsigned, std::string> argumentPaths_;
+        std::string argument0Namespace_;
+        bool pathNamespace_{};
+    };
+
+}
+
+#endif /* SDBUS_CXX_SIGNALFILTER_H_ */
@@ -0,0 +1,247 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file Task.h
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_TASK_H_
+#define SDBUS_CXX_TASK_H_
+
+// Coroutine support is available to clients that build with C++20 coroutines enabled
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define SDBUS_HAS_COROUTINES 1
+#endif
+
+#ifdef SDBUS_HAS_COROUTINES
+
+#include <exception>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace sdbus {
+
+    template <typename _Result> class Task;
+
+    namespace detail {
+
+        class TaskPromiseBase
+        {
+        public:
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            auto final_suspend() const noexcept { return FinalAwaiter{}; }
+            void unhandled_exception() { exception_ = std::current_exception(); }
+
+            void setContinuation(std::coroutine_handle<> continuation) { continuation_ = continuation; }
+            void setCompletion(std::function<void()> completion) { completion_ = std::move(completion); }
+
+        protected:
+            void rethrowIfFailed() const
+            {
+                if (exception_)
+                    std::rethrow_exception(exception_);
+            }
+
+        private:
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+                void await_resume() const noexcept {}
+
+                template <typename _Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<_Promise> handle) const noexcept
+                {
+                    auto& promise = handle.promise();
+
+                    // Awaited by another coroutine: transfer the control to it
+                    if (promise.continuation_)
+                        return promise.continuation_;
+
+                    // Detached: report the result and release the coroutine frame ourselves
+                    auto completion = std::move(promise.completion_);
+                    if (completion)
+                        completion();
+                    handle.destroy();
+                    return std::noop_coroutine();
+                }
+            };
+
+            std::exception_ptr exception_;
+            std::coroutine_handle<> continuation_;
+            std::function<void()> completion_;
+        };
+
+        template <typename _Result>
+        class TaskPromise : public TaskPromiseBase
+        {
+        public:
+            Task<_Result> get_return_object();
+            void return_value(_Result value) { value_.emplace(std::move(value)); }
+            _Result result() { rethrowIfFailed(); return std::move(*value_); }
+
+        private:
+            std::optional<_Result> value_;
+        };
+
+        template <>
+        class TaskPromise<void> : public TaskPromiseBase
+        {
+        public:
+            Task<void> get_return_object();
+            void return_void() {}
+            void result() { rethrowIfFailed(); }
+        };
+
+    }
+
+    /********************************************//**
+     * @class Task
+     *
+     * Return type of C++20 coroutines usable as D-Bus method
+     * implementations, and awaitable by other such coroutines.
+     *
+     * A coroutine returning Task<R> may be registered with
+     * @c MethodRegistrator::implementedAs(). Its body may co_await
+     * async calls on proxies or other tasks; the method reply is
+     * sent when the coroutine returns (R being the method output
+     * arguments, std::tuple for more of them), and a D-Bus error
+     * reply is sent when it throws @c sdbus::Error (any other exception
+     * yields an org.freedesktop.DBus.Error.Failed error reply).
+     *
+     * The task is lazy: its body starts running only when the task
+     * is awaited or handed over to the library.
+     *
+     ***********************************************/
+    template <typename _Result = void>
+    class Task
+    {
+    public:
+        using promise_type = detail::TaskPromise<_Result>;
+
+        Task(Task&& other) noexcept;
+        Task& operator=(Task&& other) noexcept;
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task();
+
+        bool await_ready() const noexcept;
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept;
+        _Result await_resume();
+
+        /*!
+        * @brief Starts the task without anyone awaiting it
+        *
+        * @param[in] completion Callback invoked with the promise of the task, from which
+        *                       the result of the task is retrieved, once the task is done
+        *
+        * The coroutine frame is then owned by the coroutine itself and released
+        * right after the completion callback returns.
+        */
+        void startDetached(std::function<void(promise_type&)> completion) &&;
+
+    private:
+        friend promise_type;
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept;
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    namespace detail {
+
+        template <typename _Result>
+        inline Task<_Result> TaskPromise<_Result>::get_return_object()
+        {
+            return Task<_Result>{std::coroutine_handle<TaskPromise<_Result>>::from_promise(*this)};
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object()
+        {
+            return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+        }
+
+    }
+
+    template <typename _Result>
+    inline Task<_Result>::Task(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle)
+    {
+    }
+
+    template <typename _Result>
+    inline Task<_Result>::Task(Task&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+
+    template <typename _Result>
+    inline Task<_Result>& Task<_Result>::operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle_)
+                handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    template <typename _Result>
+    inline Task<_Result>::~Task()
+    {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    template <typename _Result>
+    inline bool Task<_Result>::await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename _Result>
+    inline std::coroutine_handle<> Task<_Result>::await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept
+    {
+        handle_.promise().setContinuation(awaitingCoroutine);
+        return handle_;
+    }
+
+    template <typename _Result>
+    inline _Result Task<_Result>::await_resume()
+    {
+        return handle_.promise().result();
+    }
+
+    template <typename _Result>
+    inline void Task<_Result>::startDetached(std::function<void(promise_type&)> completion) &&
+    {
+        auto handle = std::exchange(handle_, nullptr);
+        auto& promise = handle.promise();
+        promise.setCompletion([&promise, completion = std::move(completion)](){ completion(promise); });
+        handle.resume();
+    }
+
+}
+
+#endif /* SDBUS_HAS_COROUTINES */
+
+#endif /* SDBUS_CXX_TASK_H_ */
@@ -46,6 +46,7 @@ namespace sdbus {
     class Signal;
     class MethodResult;
     template <typename... _Results> class Result;
+    template <typename _Result> class Task;
     class Error;
 }
 
@@ -57,6 +58,52 @@ namespace sdbus {
     using signal_handler = std::function<void(Signal& signal)>;
     using property_set_callback = std::function<void(Message& msg)>;
     using property_get_callback = std::function<void(Message& reply)>;
+    using dispatch_key_callback = std::function<std::size_t(const Message& msg)>;
+    using drain_report_handler = std::function<void(std::size_t drainedMessages)>;
+    using watermark_handler = std::function<void(bool congested)>;
+
+    namespace detail
+    {
+        template <std::size_t _Length>
+        struct signature_string
+        {
+            char chars_[_Length + 1]{};
+
+            constexpr std::size_t size() const
+            {
+                return _Length;
+            }
+
+            constexpr const char* c_str() const
+            {
+                return chars_;
+            }
+        };
+
+        template <std::size_t _Size>
+        constexpr signature_string<_Size - 1> make_signature(const char (&chars)[_Size])
+        {
+            signature_string<_Size - 1> signature{};
+            for (std::size_t i = 0; i < _Size - 1; ++i)
+                signature.chars_[i] = chars[i];
+            return signature;
+        }
+
+        template <std::size_t... _Lengths>
+        constexpr signature_string<(_Lengths + ... + 0)> concat_signatures(const signature_string<_Lengths>&... parts)
+        {
+            signature_string<(_Lengths + ... + 0)> signature{};
+            std::size_t pos{};
+            // Not called for an empty pack of parts
+            [[maybe_unused]] auto append = [&signature, &pos](const auto& part)
+            {
+                for (std::size_t i = 0; i < part.size(); ++i)
+                    signature.chars_[pos++] = part.chars_[i];
+            };
+            (append(parts), ...);
+            return signature;
+        }
+    }
 
     template <typename _T>
     struct signature_of
@@ -72,14 +119,22 @@ namespace sdbus {
         }
     };
 
+    // Signature of a D-Bus type as a null-terminated character array built at compile time,
+    // e.g. signature_of_v<std::vector<int32_t>>.c_str() is "ai". Basic types provide it as
+    // signature_of<_T>::value; containers specialize this template, so that signature_of<>
+    // of a container of an unsupported type can still be instantiated to check is_valid.
+    template <typename _T>
+    inline constexpr auto signature_of_v = signature_of<_T>::value;
+
     template <>
     struct signature_of<void>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("");
 
         static const std::string str()
         {
-            return "";
+            return value.c_str();
         }
     };
 
@@ -87,10 +142,11 @@ namespace sdbus {
     struct signature_of<bool>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("b");
 
         static const std::string str()
         {
-            return "b";
+            return value.c_str();
         }
     };
 
@@ -98,10 +154,11 @@ namespace sdbus {
     struct signature_of<uint8_t>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("y");
 
         static const std::string str()
         {
-            return "y";
+            return value.c_str();
         }
     };
 
@@ -109,10 +166,11 @@ namespace sdbus {
     struct signature_of<int16_t>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("n");
 
         static const std::string str()
         {
-            return "n";
+            return value.c_str();
         }
     };
 
@@ -120,10 +178,11 @@ namespace sdbus {
     struct signature_of<uint16_t>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("q");
 
         static const std::string str()
         {
-            return "q";
+            return value.c_str();
         }
     };
 
@@ -131,10 +190,11 @@ namespace sdbus {
     struct signature_of<int32_t>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("i");
 
         static const std::string str()
         {
-            return "i";
+            return value.c_str();
         }
     };
 
@@ -142,10 +202,11 @@ namespace sdbus {
     struct signature_of<uint32_t>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("u");
 
         static const std::string str()
         {
-            return "u";
+            return value.c_str();
         }
     };
 
@@ -153,10 +214,11 @@ namespace sdbus {
     struct signature_of<int64_t>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("x");
 
         static const std::string str()
         {
-            return "x";
+            return value.c_str();
         }
     };
 
@@ -164,10 +226,11 @@ namespace sdbus {
     struct signature_of<uint64_t>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("t");
 
         static const std::string str()
         {
-            return "t";
+            return value.c_str();
         }
     };
 
@@ -175,10 +238,11 @@ namespace sdbus {
     struct signature_of<double>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("d");
 
         static const std::string str()
         {
-            return "d";
+            return value.c_str();
         }
     };
 
@@ -186,10 +250,11 @@ namespace sdbus {
     struct signature_of<char*>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("s");
 
         static const std::string str()
         {
-            return "s";
+            return value.c_str();
         }
     };
 
@@ -197,10 +262,11 @@ namespace sdbus {
     struct signature_of<const char*>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("s");
 
         static const std::string str()
         {
-            return "s";
+            return value.c_str();
         }
     };
 
@@ -208,10 +274,11 @@ namespace sdbus {
     struct signature_of<char[_N]>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("s");
 
         static const std::string str()
         {
-            return "s";
+            return value.c_str();
         }
     };
 
@@ -219,10 +286,11 @@ namespace sdbus {
     struct signature_of<const char[_N]>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("s");
 
         static const std::string str()
         {
-            return "s";
+            return value.c_str();
         }
     };
 
@@ -230,10 +298,11 @@ namespace sdbus {
     struct signature_of<std::string>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("s");
 
         static const std::string str()
         {
-            return "s";
+            return value.c_str();
         }
     };
 
@@ -244,24 +313,35 @@ namespace sdbus {
 
         static const std::string str()
         {
-            std::initializer_list<std::string> signatures{signature_of<_ValueTypes>::str()...};
-            std::string signature;
-            signature += "(";
-            for (const auto& item : signatures)
-                signature += item;
-            signature += ")";
-            return signature;
+            return signature_of_v<Struct<_ValueTypes...>>.c_str();
         }
     };
 
+    namespace detail
+    {
+        // Signature of struct members, without the enclosing parentheses
+        template <typename... _ValueTypes>
+        inline constexpr auto struct_content_signature_v = concat_signatures(signature_of_v<_ValueTypes>...);
+
+        // Signature of a dictionary entry, without the enclosing braces
+        template <typename _Key, typename _Value>
+        inline constexpr auto dict_entry_signature_v = concat_signatures(signature_of_v<_Key>, signature_of_v<_Value>);
+    }
+
+    template <typename... _ValueTypes>
+    inline constexpr auto signature_of_v<Struct<_ValueTypes...>> = detail::concat_signatures( detail::make_signature("(")
+                                                                                            , detail::struct_content_signature_v<_ValueTypes...>
+                                                                                            , detail::make_signature(")") );
+
     template <>
     struct signature_of<Variant>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("v");
 
         static const std::string str()
         {
-            return "v";
+            return value.c_str();
         }
     };
 
@@ -269,10 +349,11 @@ namespace sdbus {
     struct signature_of<ObjectPath>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("o");
 
         static const std::string str()
         {
-            return "o";
+            return value.c_str();
         }
     };
 
@@ -280,10 +361,11 @@ namespace sdbus {
     struct signature_of<Signature>
     {
         static constexpr bool is_valid = true;
+        static constexpr auto value = detail::make_signature("g");
 
         static const std::string str()
         {
-            return "g";
+            return value.c_str();
         }
     };
 
@@ -294,10 +376,13 @@ namespace sdbus {
 
         static const std::string str()
         {
-            return "a" + signature_of<_Element>::str();
+            return signature_of_v<std::vector<_Element>>.c_str();
         }
     };
 
+    template <typename _Element>
+    inline constexpr auto signature_of_v<std::vector<_Element>> = detail::concat_signatures(detail::make_signature("a"), signature_of_v<_Element>);
+
     template <typename _Key, typename _Value>
     struct signature_of<std::map<_Key, _Value>>
     {
@@ -305,10 +390,30 @@ namespace sdbus {
 
         static const std::string str()
         {
-            return "a{" + signature_of<_Key>::str() + signature_of<_Value>::str() + "}";
+            return signature_of_v<std::map<_Key, _Value>>.c_str();
         }
     };
 
+    template <typename _Key, typename _Value>
+    inline constexpr auto signature_of_v<std::map<_Key, _Value>> = detail::concat_signatures( detail::make_signature("a{")
+                                                                                            , detail::dict_entry_signature_v<_Key, _Value>
+                                                                                            , detail::make_signature("}") );
+
+
+    // Types whose D-Bus arrays are plain blocks of their C++ values, so they can be copied as a whole.
+    // Not bool, which takes four bytes in D-Bus messages.
+    template <typename _T> struct is_trivial_dbus_type : std::false_type {};
+    template <> struct is_trivial_dbus_type<uint8_t> : std::true_type {};
+    template <> struct is_trivial_dbus_type<int16_t> : std::true_type {};
+    template <> struct is_trivial_dbus_type<uint16_t> : std::true_type {};
+    template <> struct is_trivial_dbus_type<int32_t> : std::true_type {};
+    template <> struct is_trivial_dbus_type<uint32_t> : std::true_type {};
+    template <> struct is_trivial_dbus_type<int64_t> : std::true_type {};
+    template <> struct is_trivial_dbus_type<uint64_t> : std::true_type {};
+    template <> struct is_trivial_dbus_type<double> : std::true_type {};
+
+    template <typename _T>
+    constexpr bool is_trivial_dbus_type_v = is_trivial_dbus_type<_T>::value;
 
     // Function traits implementation inspired by (c) kennytm,
     // https://github.com/kennytm/utils/blob/master/traits.hpp
@@ -337,6 +442,7 @@ namespace sdbus {
         typedef _ReturnType function_type(_Args...);
 
         static constexpr std::size_t arity = sizeof...(_Args);
+        static constexpr bool is_coroutine = false;
 
 //        template <size_t _Idx, typename _Enabled = void>
 //        struct arg;
@@ -390,6 +496,14 @@ namespace sdbus {
         static constexpr bool is_async = true;
     };
 
+    template <typename... _Args, typename _Result>
+    struct function_traits<Task<_Result>(_Args...)>
+        : public function_traits_base<_Result, _Args...>
+    {
+        static constexpr bool is_async = false;
+        static constexpr bool is_coroutine = true;
+    };
+
     template <typename _ReturnType, typename... _Args>
     struct function_traits<_ReturnType(*)(_Args...)>
         : public function_traits<_ReturnType(_Args...)>
@@ -431,6 +545,9 @@ namespace sdbus {
     template <class _Function>
     constexpr auto is_async_method_v = function_traits<_Function>::is_async;
 
+    template <class _Function>
+    constexpr auto is_coroutine_method_v = function_traits<_Function>::is_coroutine;
+
     template <typename _FunctionType>
     using function_arguments_t = typename function_traits<_FunctionType>::arguments_type;
 
@@ -461,12 +578,35 @@ namespace sdbus {
     template <typename _Function>
     using tuple_of_function_output_arg_types_t = typename tuple_of_function_output_arg_types<_Function>::type;
 
+    // Type of the value an async method call delivers to its caller: void for no
+    // output arguments, the type itself for one, and a tuple of the types for more.
+    template <typename... _Args>
+    struct future_return
+    {
+        typedef std::tuple<_Args...> type;
+    };
+
+    template <>
+    struct future_return<>
+    {
+        typedef void type;
+    };
+
+    template <typename _Type>
+    struct future_return<_Type>
+    {
+        typedef _Type type;
+    };
+
+    template <typename... _Args>
+    using future_return_t = typename future_return<_Args...>::type;
+
     template <typename _Type>
     struct aggregate_signature
     {
         static const std::string str()
         {
-            return signature_of<std::decay_t<_Type>>::str();
+            return signature_of_v<std::decay_t<_Type>>.c_str();
         }
     };
 
@@ -475,12 +615,7 @@ namespace sdbus {
     {
         static const std::string str()
         {
-            // TODO: This could be a fold expression in C++17...
-            std::initializer_list<std::string> signatures{signature_of<std::decay_t<_Types>>::str()...};
-            std::string signature;
-            for (const auto& item : signatures)
-                signature += item;
-            return signature;
+            return detail::concat_signatures(signature_of_v<std::decay_t<_Types>>...).c_str();
         }
     };
 
@@ -57,7 +57,7 @@ namespace sdbus {
         Variant(const _ValueType& value)
             : Variant()
         {
-            msg_.openVariant(signature_of<_ValueType>::str());
+            msg_.openVariant(signature_of_v<_ValueType>.c_str());
             msg_ << value;
             msg_.closeVariant();
             msg_.seal();
@@ -68,7 +68,7 @@ namespace sdbus {
         {
             _ValueType val;
             msg_.rewind(false);
-            msg_.enterVariant(signature_of<_ValueType>::str());
+            msg_.enterVariant(signature_of_v<_ValueType>.c_str());
             msg_ >> val;
             msg_.exitVariant();
             return val;
@@ -84,7 +84,7 @@ namespace sdbus {
         template <typename _Type>
         bool containsValueOfType() const
         {
-            return signature_of<_Type>::str() == peekValueType();
+            return peekValueType() == signature_of_v<_Type>.c_str();
         }
 
         bool isEmpty() const;
@@ -24,12 +24,16 @@
  */
 
 #include <sdbus-c++/IConnection.h>
+#include <sdbus-c++/IConnectionPool.h>
+#include <sdbus-c++/IExecutor.h>
 #include <sdbus-c++/IObject.h>
 #include <sdbus-c++/IObjectProxy.h>
 #include <sdbus-c++/Interfaces.h>
 #include <sdbus-c++/Message.h>
 #include <sdbus-c++/MethodResult.h>
+#include <sdbus-c++/Task.h>
 #include <sdbus-c++/Types.h>
 #include <sdbus-c++/TypeTraits.h>
 #include <sdbus-c++/Introspection.h>
+#include <sdbus-c++/SignalFilter.h>
 #include <sdbus-c++/Error.h>
@@ -27,32 +27,129 @@
 #include "SdBus.h"
 #include <sdbus-c++/Message.h>
 #include <sdbus-c++/Error.h>
+#include <sdbus-c++/SignalFilter.h>
 #include "ScopeGuard.h"
 #include <systemd/sd-bus.h>
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <atomic>
 #include <unistd.h>
-#include <poll.h>
 #include <sys/eventfd.h>
 
 namespace sdbus { namespace internal {
 
+namespace {
+    // Messages held back by cork(), per thread and connection corked in that thread
+    struct Cork
+    {
+        uint64_t connectionKey;
+        unsigned depth;
+        std::vector<sd_bus_message*> messages;
+    };
+    thread_local std::vector<Cork> corks;
+    std::atomic<uint64_t> nextCorkKey{};
+
+    std::vector<Cork>::iterator findCork(uint64_t connectionKey)
+    {
+        return std::find_if(corks.begin(), corks.end(), [connectionKey](const Cork& cork){ return cork.connectionKey == connectionKey; });
+    }
+
+    // Values in match rules are single-quoted. A quote inside a value thus ends the quoted
+    // part, gets escaped by a backslash outside of quotes, and the quoted part starts over.
+    std::string quoteMatchRuleValue(const std::string& value)
+    {
+        std::string quoted{"'"};
+        for (auto c : value)
+        {
+            if (c == '\'')
+                quoted += "'\\''";
+            else
+                quoted += c;
+        }
+        quoted += '\'';
+
+        return quoted;
+    }
+
+    // Signals filtered by their arguments or by a path namespace keep match rules of their own
+    bool isDemultiplexable(const SignalFilter& filter)
+    {
+        return filter.getArguments().empty()
+            && filter.getArgumentPaths().empty()
+            && filter.getArgument0Namespace().empty()
+            && !filter.isPathNamespace();
+    }
+
+    // Bus name requested along with the connection handshake
+    struct NameRequest
+    {
+        ISdBus* sdbus;
+        int result; // Positive once granted, negative errno once refused
+    };
+}
+
 Connection::Connection(Connection::BusType type, std::unique_ptr<ISdBus>&& interface)
+    : Connection(std::move(interface), type, makeBusFactory(type))
+{
+}
+
+Connection::Connection(Connection::BusType type, std::unique_ptr<ISdBus>&& interface, const std::string& name, request_name_t)
+    : Connection(std::move(interface), type, makeBusFactory(type), name)
+{
+    SDBUS_THROW_ERROR_IF(name.empty(), "Invalid bus name provided", EINVAL);
+}
+
+Connection::Connection(Connection::BusType type, std::unique_ptr<ISdBus>&& interface, int fd)
+    : Connection(std::move(interface), type, [type, fd](ISdBus& iface, sd_bus** bus)
+                                             {
+                                                 assert(type == BusType::eDirect || type == BusType::eServer);
+                                                 return type == BusType::eDirect ? iface.sd_bus_open_direct(bus, fd) : iface.sd_bus_open_server(bus, fd);
+                                             })
+{
+}
+
+Connection::Connection(Connection::BusType type, std::unique_ptr<ISdBus>&& interface, const std::string& address)
+    : Connection(std::move(interface), type, [type, &address](ISdBus& iface, sd_bus** bus)
+                                             {
+                                                 assert(type == BusType::eDirect);
+                                                 return iface.sd_bus_open_direct(bus, address.c_str());
+                                             })
+{
+}
+
+Connection::Connection(std::unique_ptr<ISdBus>&& interface, BusType type, const BusFactory& busFactory, const std::string& name)
     : iface_(std::move(interface))
     , busType_(type)
+    , corkKey_(nextCorkKey.fetch_add(1, std::memory_order_relaxed))
 {
     assert(iface_ != nullptr);
 
-    auto bus = openBus(busType_);
+    auto bus = openBus(busFactory);
     bus_.reset(bus);
 
-    finishHandshake(bus);
+    // Peer-to-peer connections have no bus daemon that would time out the authentication. Their
+    // handshake completes in the processing loop or on first use, so that both peers may be set up
+    // from one thread (e.g. over a socketpair) without blocking on each other.
+    if (busType_ == BusType::eSystem || busType_ == BusType::eSession)
+        name.empty() ? finishHandshake(bus) : finishHandshake(bus, name);
 
     loopExitFd_ = createProcessingLoopExitDescriptor();
+    loopWakeUpFd_ = createProcessingLoopWakeUpDescriptor();
+    waitBackend_ = std::make_unique<PollWaitBackend>(loopExitFd_, loopWakeUpFd_);
 }
 
 Connection::~Connection()
 {
     leaveProcessingLoop();
-    closeProcessingLoopExitDescriptor(loopExitFd_);
+    dispatcher_.reset(); // Handles all messages already dispatched to workers
+    if (sendHookInstalled_)
+        iface_->sd_bus_set_send_hook(nullptr, nullptr);
+    sendQueuedMessages(); // Sends what was queued after the loop had finished
+    dropCork();
+    waitBackend_.reset();
+    closeProcessingLoopDescriptor(loopWakeUpFd_);
+    closeProcessingLoopDescriptor(loopExitFd_);
 }
 
 void Connection::requestName(const std::string& name)
@@ -69,16 +166,39 @@ void Connection::releaseName(const std::string& name)
 
 void Connection::enterProcessingLoop()
 {
-    while (true)
+    loopThreadId_ = std::this_thread::get_id();
+    SCOPE_EXIT
     {
-        auto processed = processPendingRequest();
-        if (processed)
-            continue; // Process next one
+        loopThreadId_ = std::thread::id{};
+        notifyBlockedSenders(); // Nobody drains the write queue for them anymore
+        notifyLoopExitHandlers(); // Nor processes the replies they wait for
+    };
 
-        auto success = waitForNextRequest();
+    std::size_t drainedMessages{};
+    while (true)
+    {
+        sendQueuedMessages();
+
+        ISdBus::PollData pollData{};
+        std::size_t processed{};
+        auto idle = !processPendingRequestBatch(pollData, processed);
+        drainedMessages += processed;
+        updateWriteQueueState();
+        if (idle)
+        {
+            if (drainReportHandler_)
+                drainReportHandler_(drainedMessages);
+            drainedMessages = 0;
+        }
+
+        // Between batches, this does not block, but lets exit requests and wakeups in even
+        // when messages keep coming
+        auto success = waitForNextRequest(pollData);
         if (!success)
             break; // Exit processing loop
     }
+
+    sendQueuedMessages();
 }
 
 void Connection::enterProcessingLoopAsync()
@@ -93,6 +213,218 @@ void Connection::leaveProcessingLoop()
     joinWithProcessingLoop();
 }
 
+sdbus::IConnection::PollData Connection::getEventLoopPollData() const
+{
+    ISdBus::PollData pollData;
+    auto r = iface_->sd_bus_get_poll_data(bus_.get(), &pollData);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to get bus poll data", -r);
+
+    return {pollData.fd, pollData.events, pollData.timeout_usec};
+}
+
+void Connection::setProcessingBudget(std::size_t maxMessages, std::chrono::microseconds maxDuration)
+{
+    SDBUS_THROW_ERROR_IF(isProcessingLoopRunning(), "Cannot change processing budget while processing loop is running", EBUSY);
+    SDBUS_THROW_ERROR_IF(maxDuration.count() < 0, "Invalid processing batch duration", EINVAL);
+
+    maxMessagesPerBatch_ = maxMessages;
+    maxBatchDuration_ = maxDuration;
+}
+
+void Connection::setDrainReportHandler(drain_report_handler handler)
+{
+    SDBUS_THROW_ERROR_IF(isProcessingLoopRunning(), "Cannot set drain report handler while processing loop is running", EBUSY);
+
+    drainReportHandler_ = std::move(handler);
+}
+
+void Connection::enableMultithreadedDispatch(std::size_t workerCount, dispatch_key_callback keyCallback)
+{
+    SDBUS_THROW_ERROR_IF(isProcessingLoopRunning(), "Cannot enable multi-threaded dispatch while processing loop is running", EBUSY);
+    SDBUS_THROW_ERROR_IF(dispatcher_ != nullptr, "Multi-threaded dispatch is already enabled", EALREADY);
+
+    dispatcher_ = std::make_unique<Dispatcher>(workerCount);
+    dispatchKeyCallback_ = std::move(keyCallback);
+}
+
+void Connection::setMethodCallTimeout(uint64_t timeout)
+{
+    auto r = iface_->sd_bus_set_method_call_timeout(bus_.get(), timeout);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to set method call timeout", -r);
+}
+
+uint64_t Connection::getMethodCallTimeout() const
+{
+    uint64_t timeout{};
+    auto r = iface_->sd_bus_get_method_call_timeout(bus_.get(), &timeout);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to get method call timeout", -r);
+
+    return timeout;
+}
+
+void Connection::setEventLoopBackend(EventLoopBackend backend)
+{
+    SDBUS_THROW_ERROR_IF(isProcessingLoopRunning(), "Cannot change event loop backend while processing loop is running", EBUSY);
+
+    if (backend == waitBackendType_)
+        return;
+
+    if (backend == EventLoopBackend::eIoUring)
+    {
+        try
+        {
+            waitBackend_ = std::make_unique<IoUringWaitBackend>(loopExitFd_, loopWakeUpFd_);
+        }
+        catch (const sdbus::Error&)
+        {
+            return; // io_uring is unavailable (old kernel, disabled by sysctl or seccomp), stay with poll
+        }
+    }
+    else
+        waitBackend_ = std::make_unique<PollWaitBackend>(loopExitFd_, loopWakeUpFd_);
+
+    waitBackendType_ = backend;
+}
+
+void Connection::enableShardedDispatch(const std::vector<unsigned>& cpus, dispatch_key_callback keyCallback)
+{
+    SDBUS_THROW_ERROR_IF(isProcessingLoopRunning(), "Cannot enable sharded dispatch while processing loop is running", EBUSY);
+    SDBUS_THROW_ERROR_IF(dispatcher_ != nullptr, "Multi-threaded dispatch is already enabled", EALREADY);
+
+    dispatcher_ = std::make_unique<Dispatcher>(cpus);
+    dispatchKeyCallback_ = std::move(keyCallback);
+}
+
+void Connection::enableOutboundQueue()
+{
+    SDBUS_THROW_ERROR_IF(isProcessingLoopRunning(), "Cannot enable outbound queue while processing loop is running", EBUSY);
+    SDBUS_THROW_ERROR_IF(outboundQueue_ != nullptr, "Outbound queue is already enabled", EALREADY);
+
+    outboundQueue_ = std::make_unique<OutboundQueue>();
+    installSendHook();
+}
+
+void Connection::enableSignalDemultiplexing()
+{
+    SDBUS_THROW_ERROR_IF(isProcessingLoopRunning(), "Cannot enable signal demultiplexing while processing loop is running", EBUSY);
+    SDBUS_THROW_ERROR_IF(signalDemultiplexer_ != nullptr, "Signal demultiplexing is already enabled", EALREADY);
+
+    signalDemultiplexer_ = std::make_unique<SignalDemultiplexer>();
+}
+
+void Connection::setWriteQueueLimit(std::size_t maxMessages, OverflowPolicy policy)
+{
+    SDBUS_THROW_ERROR_IF(isProcessingLoopRunning(), "Cannot set write queue limit while processing loop is running", EBUSY);
+
+    writeQueueLimit_ = maxMessages;
+    overflowPolicy_ = policy;
+    installSendHook();
+}
+
+void Connection::setWriteQueueWatermarks(std::size_t lowWatermark, std::size_t highWatermark, watermark_handler handler)
+{
+    SDBUS_THROW_ERROR_IF(isProcessingLoopRunning(), "Cannot set write queue watermarks while processing loop is running", EBUSY);
+    SDBUS_THROW_ERROR_IF(lowWatermark >= highWatermark, "Invalid write queue watermarks", EINVAL);
+
+    lowWatermark_ = lowWatermark;
+    highWatermark_ = highWatermark;
+    watermarkHandler_ = std::move(handler);
+    installSendHook();
+}
+
+std::size_t Connection::getWriteQueueDepth() const
+{
+    uint64_t depth{};
+    auto r = iface_->sd_bus_get_n_queued_write(bus_.get(), &depth);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to get write queue depth", -r);
+
+    return depth;
+}
+
+void Connection::cork()
+{
+    installSendHook();
+
+    auto it = findCork(corkKey_);
+    if (it == corks.end())
+        it = corks.insert(corks.end(), Cork{corkKey_, 0, {}});
+    ++it->depth;
+}
+
+void Connection::uncork()
+{
+    auto it = findCork(corkKey_);
+    SDBUS_THROW_ERROR_IF(it == corks.end(), "Connection is not corked in this thread", EINVAL);
+
+    if (--it->depth > 0)
+        return; // Nested cork, the outermost one sends the messages
+
+    auto messages = std::move(it->messages);
+    corks.erase(it);
+
+    if (shallQueueOutgoingMessages())
+    {
+        queueOutgoingMessages(messages);
+        return;
+    }
+
+    // All messages are sent, even if some fail, as the senders consider them sent already
+    auto r = iface_->sd_bus_send_batch(bus_.get(), messages.data(), messages.size());
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to send corked messages", -r);
+}
+
+void Connection::dropCork()
+{
+    // Corked in this thread and never uncorked. Corks of other threads cannot be reached from here,
+    // but they are a bug of their own then, as their uncork() would hit a destroyed connection.
+    auto it = findCork(corkKey_);
+    if (it == corks.end())
+        return;
+
+    for (auto* message : it->messages)
+        iface_->sd_bus_message_unref(message);
+    corks.erase(it);
+}
+
+sdbus::IConnection::EventLoopBackend Connection::getEventLoopBackend() const
+{
+    return waitBackendType_;
+}
+
+bool Connection::isProcessingLoopRunning() const
+{
+    return loopThreadId_.load() != std::thread::id{};
+}
+
+bool Connection::isInProcessingLoopThread() const
+{
+    return loopThreadId_.load() == std::this_thread::get_id();
+}
+
+void Connection::wakeUpProcessingLoop()
+{
+    assert(loopWakeUpFd_ >= 0);
+
+    // The loop shall re-read bus poll data, e.g. after a message has been queued
+    // or a method call with a new reply timeout has been issued from another thread.
+    uint64_t value = 1;
+    auto r = write(loopWakeUpFd_, &value, sizeof(value));
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to wake up processing loop", -errno);
+}
+
+bool Connection::isDispatchingToWorkers() const
+{
+    return dispatcher_ != nullptr;
+}
+
+void Connection::dispatchToWorkers(const Message& message, std::function<void()> handler)
+{
+    assert(dispatcher_ != nullptr);
+
+    auto key = dispatchKeyCallback_ ? dispatchKeyCallback_(message) : std::hash<std::string>{}(message.getPath());
+    dispatcher_->post(key, std::move(handler));
+}
+
 const ISdBus& Connection::getSdBusInterface() const
 {
     return *iface_.get();
@@ -134,9 +466,10 @@ MethodCall Connection::createMethodCall( const std::string& destination
 {
     sd_bus_message *sdbusMsg{};
 
+    // Messages on peer-to-peer connections carry no destination
     auto r = iface_->sd_bus_message_new_method_call( bus_.get()
                                                    , &sdbusMsg
-                                                   , destination.c_str()
+                                                   , !destination.empty() ? destination.c_str() : nullptr
                                                    , objectPath.c_str()
                                                    , interfaceName.c_str()
                                                    , methodName.c_str() );
@@ -163,37 +496,269 @@ Signal Connection::createSignal( const std::string& objectPath
     return Signal{sdbusSignal, iface_.get(), adopt_message};
 }
 
-sd_bus_slot* Connection::registerSignalHandler( const std::string& objectPath
-                                              , const std::string& interfaceName
-                                              , const std::string& signalName
-                                              , sd_bus_message_handler_t callback
-                                              , void* userData )
+SignalSlot Connection::registerSignalHandler( const std::string& objectPath
+                                            , const std::string& interfaceName
+                                            , const std::string& signalName
+                                            , const SignalFilter& filter
+                                            , sd_bus_message_handler_t callback
+                                            , sd_bus_message_handler_t installCallback
+                                            , void* userData )
 {
+    if (signalDemultiplexer_ != nullptr && isDemultiplexable(filter))
+        return registerDemultiplexedSignalHandler(objectPath, interfaceName, signalName, callback, installCallback, userData);
+
     sd_bus_slot *slot{};
 
-    auto filter = composeSignalMatchFilter(objectPath, interfaceName, signalName);
-    auto r = iface_->sd_bus_add_match(bus_.get(), &slot, filter.c_str(), callback, userData);
+    auto match = composeSignalMatchFilter(objectPath, interfaceName, signalName, filter);
+    auto r = addMatch(&slot, match, callback, installCallback, userData, isDispatchingInCallingThread());
 
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to register signal handler", -r);
 
-    return slot;
+    return {slot, [this](void* slot){ iface_->sd_bus_slot_unref(static_cast<sd_bus_slot*>(slot)); }};
+}
+
+SignalSlot Connection::registerDemultiplexedSignalHandler( const std::string& objectPath
+                                                         , const std::string& interfaceName
+                                                         , const std::string& signalName
+                                                         , sd_bus_message_handler_t callback
+                                                         , sd_bus_message_handler_t installCallback
+                                                         , void* userData )
+{
+    acquireInterfaceMatch(interfaceName, installCallback, userData);
+    SCOPE_EXIT_NAMED(releaseMatchOnException){ releaseInterfaceMatch(interfaceName, userData); };
+
+    auto* route = signalDemultiplexer_->addRoute(objectPath, interfaceName, signalName, callback, userData);
+    releaseMatchOnException.dismiss();
+
+    return {route, [this](void* route)
+    {
+        auto* signalRoute = static_cast<SignalDemultiplexer::Route*>(route);
+        auto interfaceName = signalRoute->interfaceName_;
+        auto userData = signalRoute->userData_;
+        signalDemultiplexer_->removeRoute(signalRoute);
+        releaseInterfaceMatch(interfaceName, userData);
+    }};
+}
+
+void Connection::acquireInterfaceMatch(const std::string& interfaceName, sd_bus_message_handler_t installCallback, void* userData)
+{
+    // Asked before locking, as it takes the bus lock, which is held when install replies take our lock
+    const auto synchronously = isDispatchingInCallingThread();
+
+    std::unique_lock<std::mutex> lock(interfaceMatchesMutex_);
+
+    auto& match = interfaceMatches_[interfaceName];
+    match.connection_ = this;
+    ++match.refCount_;
+
+    // Only subscribers whose match is still to be confirmed by the daemon wait for the install reply
+    auto awaitInstallReply = [&]()
+    {
+        if (installCallback != nullptr)
+            match.pendingInstallCallbacks_.emplace_back(installCallback, userData);
+    };
+
+    while (match.adding_)
+    {
+        // The thread adding the match waits for the bus lock that the loop thread holds
+        // while it runs handlers. It finds our reference once it gets the lock and keeps the match.
+        // Having a running loop, it adds the match asynchronously, so its reply reaches us, too.
+        if (isInProcessingLoopThread())
+        {
+            awaitInstallReply();
+            return;
+        }
+        interfaceMatchesCond_.wait(lock);
+    }
+
+    if (match.slot_ != nullptr)
+    {
+        if (match.awaitingInstallReply_)
+            awaitInstallReply();
+        return;
+    }
+
+    awaitInstallReply();
+    try
+    {
+        addInterfaceMatch(lock, interfaceName, match, synchronously);
+    }
+    catch (...)
+    {
+        --match.refCount_;
+        auto& pending = match.pendingInstallCallbacks_;
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [userData](const auto& c){ return c.second == userData; }), pending.end());
+        throw;
+    }
 }
 
-void Connection::unregisterSignalHandler(sd_bus_slot* handlerCookie)
+void Connection::releaseInterfaceMatch(const std::string& interfaceName, void* userData)
 {
-    iface_->sd_bus_slot_unref(handlerCookie);
+    std::unique_lock<std::mutex> lock(interfaceMatchesMutex_);
+
+    auto& match = interfaceMatches_.at(interfaceName);
+    auto& pending = match.pendingInstallCallbacks_;
+    pending.erase(std::remove_if(pending.begin(), pending.end(), [userData](const auto& c){ return c.second == userData; }), pending.end());
+
+    // A thread adding the match right now takes care of the reference count once done
+    if (--match.refCount_ > 0 || match.adding_ || match.slot_ == nullptr)
+        return;
+
+    // Subscribers coming meanwhile add the match anew, in their own acquireInterfaceMatch()
+    match.awaitingInstallReply_ = false;
+    removeInterfaceMatch(lock, match, std::exchange(match.slot_, nullptr));
 }
 
-sd_bus* Connection::openBus(Connection::BusType type)
+void Connection::addInterfaceMatch( std::unique_lock<std::mutex>& lock
+                                   , const std::string& interfaceName
+                                   , InterfaceMatch& match
+                                   , bool synchronously )
+{
+    match.adding_ = true;
+    // Set ahead, since the reply may be handled before we get the lock back
+    match.awaitingInstallReply_ = !synchronously;
+    lock.unlock();
+
+    // Without path, the rule matches signals of all objects implementing the interface
+    auto rule = "type='signal',interface=" + quoteMatchRuleValue(interfaceName);
+    sd_bus_slot *slot{};
+    auto r = addMatch(&slot, rule, &Connection::sdbus_demultiplexed_signal_callback, &Connection::sdbus_interface_match_installed, &match, synchronously);
+
+    lock.lock();
+    match.adding_ = false;
+    interfaceMatchesCond_.notify_all();
+
+    // A match added synchronously is confirmed already, its install callback is never called
+    if (r < 0 || !match.awaitingInstallReply_)
+    {
+        match.awaitingInstallReply_ = false;
+        match.pendingInstallCallbacks_.clear();
+    }
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to register signal handler", -r);
+
+    // Everybody unsubscribed while the match was being added
+    if (match.refCount_ == 0)
+    {
+        removeInterfaceMatch(lock, match, slot);
+        return;
+    }
+
+    match.slot_ = slot;
+}
+
+void Connection::removeInterfaceMatch(std::unique_lock<std::mutex>& lock, InterfaceMatch& match, sd_bus_slot* slot)
+{
+    // Until the slot is gone, signals it still gets are left to its replacement, if any
+    match.removedSlots_.push_back(slot);
+    lock.unlock();
+    iface_->sd_bus_slot_unref(slot);
+    lock.lock();
+
+    auto& removed = match.removedSlots_;
+    removed.erase(std::find(removed.begin(), removed.end(), slot));
+}
+
+int Connection::addMatch( sd_bus_slot** slot
+                        , const std::string& rule
+                        , sd_bus_message_handler_t callback
+                        , sd_bus_message_handler_t installCallback
+                        , void* userData
+                        , bool synchronously )
+{
+    // A refusal of an async match reaches the install callback only once the bus gets processed. Subscribers learn
+    // about refusals upon a barrier call, before whose reply either our processing loop handles the refusal, or the
+    // subscriber processes the bus itself (see processMatchInstallReplies()). So all match rules of a subscription
+    // take one round trip. Only where the bus cannot be processed -- within message dispatch, as callers tell by
+    // isDispatchingInCallingThread() -- we rather wait for the daemon right here.
+    if (synchronously)
+        return iface_->sd_bus_add_match(bus_.get(), slot, rule.c_str(), callback, userData);
+
+    return iface_->sd_bus_add_match_async(bus_.get(), slot, rule.c_str(), callback, installCallback, userData);
+}
+
+bool Connection::isDispatchingInCallingThread() const
+{
+    if (isProcessingLoopRunning())
+        return isInProcessingLoopThread();
+
+    // Without our loop, messages may still be dispatched through processPendingRequest(). The bus lock is held
+    // throughout a dispatch, so a current message seen here can only be one dispatched by the calling thread.
+    return iface_->sd_bus_get_current_message(bus_.get()) != nullptr;
+}
+
+void Connection::processMatchInstallReplies()
+{
+    // A running loop handles the replies by itself, and within message dispatch the rules were added synchronously
+    if (isProcessingLoopRunning() || isDispatchingInCallingThread())
+        return;
+
+    // The replies are queued ahead of the reply that the caller has got. Whatever else is queued ahead
+    // of them gets dispatched, too, like it would by the next processPendingRequest() call.
+    while (processPendingRequest())
+        ;
+}
+
+int Connection::sdbus_demultiplexed_signal_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* match = static_cast<InterfaceMatch*>(userData);
+    assert(match != nullptr);
+
+    const auto* objectPath = sd_bus_message_get_path(sdbusMessage);
+    const auto* interfaceName = sd_bus_message_get_interface(sdbusMessage);
+    const auto* signalName = sd_bus_message_get_member(sdbusMessage);
+    if (objectPath == nullptr || interfaceName == nullptr || signalName == nullptr)
+        return 0;
+
+    auto* connection = match->connection_;
+    {
+        std::lock_guard<std::mutex> lock(connection->interfaceMatchesMutex_);
+        auto* slot = sd_bus_get_current_slot(sd_bus_message_get_bus(sdbusMessage));
+        const auto& removed = match->removedSlots_;
+        if (slot != match->slot_ && std::find(removed.begin(), removed.end(), slot) != removed.end())
+            return 0;
+    }
+
+    connection->signalDemultiplexer_->dispatch(objectPath, interfaceName, signalName, sdbusMessage, retError);
+
+    // Let other match rules, e.g. filtered subscriptions, see the signal too
+    return 0;
+}
+
+int Connection::sdbus_interface_match_installed(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+{
+    auto* match = static_cast<InterfaceMatch*>(userData);
+    assert(match != nullptr);
+
+    // Subscribers joining from now on find the match confirmed and do not wait for a reply
+    std::lock_guard<std::mutex> lock(match->connection_->interfaceMatchesMutex_);
+    match->awaitingInstallReply_ = false;
+    auto pending = std::move(match->pendingInstallCallbacks_);
+    match->pendingInstallCallbacks_.clear();
+    for (const auto& installCallback : pending)
+        installCallback.first(sdbusMessage, installCallback.second, retError);
+
+    return 0;
+}
+
+bool Connection::isConnectedToBusDaemon() const
+{
+    return busType_ == BusType::eSystem || busType_ == BusType::eSession;
+}
+
+Connection::BusFactory Connection::makeBusFactory(BusType type)
+{
+    return [type](ISdBus& iface, sd_bus** bus)
+    {
+        assert(type == BusType::eSystem || type == BusType::eSession);
+        return type == BusType::eSystem ? iface.sd_bus_open_system(bus) : iface.sd_bus_open_user(bus);
+    };
+}
+
+sd_bus* Connection::openBus(const BusFactory& busFactory)
 {
     sd_bus* bus{};
-    int r = 0;
-    if (type == BusType::eSystem)
-        r = iface_->sd_bus_open_system(&bus);
-    else if (type == BusType::eSession)
-        r = iface_->sd_bus_open_user(&bus);
-    else
-        assert(false);
+    int r = busFactory(*iface_, &bus);
 
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to open bus", -r);
     assert(bus != nullptr);
@@ -214,6 +779,73 @@ void Connection::finishHandshake(sd_bus* bus)
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to flush bus on opening", -r);
 }
 
+void Connection::finishHandshake(sd_bus* bus, const std::string& name)
+{
+    // The name request is queued right behind the Hello message, so the daemon answers
+    // both in one go, instead of us waiting for Hello and then for RequestName in turn.
+
+    assert(bus != nullptr);
+
+    NameRequest request{iface_.get(), 0};
+
+    sd_bus_slot* slot{};
+    auto r = iface_->sd_bus_request_name_async(bus, &slot, name.c_str(), 0, &Connection::sdbus_name_request_callback, &request);
+    if (r == -EOPNOTSUPP) // Too old libsystemd
+    {
+        finishHandshake(bus);
+        requestName(name);
+        return;
+    }
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to request bus name", -r);
+    SCOPE_EXIT{ iface_->sd_bus_slot_unref(slot); };
+
+    while (request.result == 0)
+    {
+        r = iface_->sd_bus_process(bus, nullptr);
+        SDBUS_THROW_ERROR_IF(r < 0, "Failed to process bus on opening", -r);
+        if (r > 0)
+            continue;
+
+        r = iface_->sd_bus_wait(bus, UINT64_MAX);
+        SDBUS_THROW_ERROR_IF(r < 0 && r != -EINTR, "Failed to wait on bus on opening", -r);
+    }
+
+    SDBUS_THROW_ERROR_IF(request.result < 0, "Failed to request bus name", -request.result);
+}
+
+int Connection::sdbus_name_request_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error */*retError*/)
+{
+    auto* request = static_cast<NameRequest*>(userData);
+    assert(request != nullptr);
+
+    const auto* error = sd_bus_message_get_error(sdbusMessage);
+    if (error != nullptr)
+    {
+        auto errorNumber = sd_bus_error_get_errno(error);
+        request->result = errorNumber != 0 ? -errorNumber : -EIO;
+        return 1;
+    }
+
+    // Interpreted the same way as by sd_bus_request_name(), which does not queue for the name either
+    enum : uint32_t { ePrimaryOwner = 1, eInQueue = 2, eExists = 3, eAlreadyOwner = 4 };
+    try
+    {
+        uint32_t ret{};
+        MethodReply reply{sdbusMessage, request->sdbus};
+        reply >> ret;
+        request->result = ret == ePrimaryOwner || ret == eInQueue ? 1
+                        : ret == eExists ? -EEXIST
+                        : ret == eAlreadyOwner ? -EALREADY
+                        : -EIO;
+    }
+    catch (const sdbus::Error&)
+    {
+        request->result = -EBADMSG;
+    }
+
+    return 1;
+}
+
 int Connection::createProcessingLoopExitDescriptor()
 {
     auto r = eventfd(0, EFD_SEMAPHORE | EFD_CLOEXEC | EFD_NONBLOCK);
@@ -223,7 +855,16 @@ int Connection::createProcessingLoopExitDescriptor()
     return r;
 }
 
-void Connection::closeProcessingLoopExitDescriptor(int fd)
+int Connection::createProcessingLoopWakeUpDescriptor()
+{
+    auto r = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to create event object", -errno);
+
+    return r;
+}
+
+void Connection::closeProcessingLoopDescriptor(int fd)
 {
     close(fd);
 }
@@ -244,12 +885,199 @@ void Connection::clearExitNotification()
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to read from the event descriptor", -errno);
 }
 
+void Connection::clearWakeUpNotification()
+{
+    uint64_t value{};
+    auto r = read(loopWakeUpFd_, &value, sizeof(value));
+    SDBUS_THROW_ERROR_IF(r < 0 && errno != EAGAIN, "Failed to read from the event descriptor", -errno);
+}
+
 void Connection::joinWithProcessingLoop()
 {
+    // Left from a callback in the loop thread: the loop exits as soon as the callback returns
+    if (isInProcessingLoopThread())
+        return;
+
     if (asyncLoopThread_.joinable())
         asyncLoopThread_.join();
 }
 
+void Connection::installSendHook()
+{
+    if (!sendHookInstalled_.exchange(true))
+        iface_->sd_bus_set_send_hook(&Connection::sdbus_send_hook, this);
+}
+
+int Connection::sdbus_send_hook(sd_bus_message *sdbusMessage, void *userData)
+{
+    auto* connection = static_cast<Connection*>(userData);
+    assert(connection != nullptr);
+
+    // The cork and the queue hold their own references, as the sender releases its message as soon as send() returns
+    auto it = findCork(connection->corkKey_);
+    if (it != corks.end())
+    {
+        connection->iface_->sd_bus_message_ref(sdbusMessage);
+        it->messages.push_back(sdbusMessage);
+        return 1;
+    }
+
+    auto r = connection->applyWriteQueueBackpressure();
+    if (r != 0)
+        return r; // Dropped or refused
+
+    if (!connection->shallQueueOutgoingMessages())
+        return 0;
+
+    connection->iface_->sd_bus_message_ref(sdbusMessage);
+    if (connection->outboundQueue_->push(sdbusMessage))
+        connection->wakeUpProcessingLoop();
+
+    return 1;
+}
+
+int Connection::applyWriteQueueBackpressure()
+{
+    if (writeQueueLimit_ == 0 && !watermarkHandler_)
+        return 0;
+
+    uint64_t depth{};
+    if (iface_->sd_bus_get_n_queued_write(bus_.get(), &depth) < 0)
+        return 0; // Not supported by libsystemd, no backpressure then
+
+    // The loop polls for writability only if it saw a non-empty write queue before going to sleep
+    if (depth > 0 && isProcessingLoopRunning() && !isInProcessingLoopThread())
+        wakeUpProcessingLoop();
+
+    if (watermarkHandler_ && depth >= highWatermark_ && !writeQueueCongested_)
+        notifyWriteQueueCongestion(true);
+
+    if (writeQueueLimit_ == 0 || depth < writeQueueLimit_)
+        return 0;
+
+    switch (overflowPolicy_)
+    {
+        case OverflowPolicy::eFailFast:
+            return -ENOBUFS;
+        case OverflowPolicy::eDropNewest:
+            return 1;
+        case OverflowPolicy::eBlock:
+            waitForWriteQueueToDrain();
+            return 0;
+    }
+
+    return 0;
+}
+
+void Connection::waitForWriteQueueToDrain()
+{
+    // Nobody else would drain the queue for us, so let's write it out in place
+    if (!isProcessingLoopRunning() || isInProcessingLoopThread())
+    {
+        iface_->sd_bus_flush(bus_.get());
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(writeQueueMutex_);
+    ++blockedSenders_;
+    writeQueueCond_.wait(lock, [this]()
+    {
+        uint64_t depth{};
+        return !isProcessingLoopRunning()
+            || iface_->sd_bus_get_n_queued_write(bus_.get(), &depth) < 0
+            || depth < writeQueueLimit_;
+    });
+    --blockedSenders_;
+}
+
+void Connection::updateWriteQueueState()
+{
+    // Only the loop drains the write queue, so only the loop detects the recovery
+    if (!writeQueueCongested_ && blockedSenders_ == 0)
+        return;
+
+    uint64_t depth{};
+    if (iface_->sd_bus_get_n_queued_write(bus_.get(), &depth) < 0)
+        return;
+
+    if (writeQueueCongested_ && depth <= lowWatermark_)
+        notifyWriteQueueCongestion(false);
+
+    if (blockedSenders_ > 0 && depth < writeQueueLimit_)
+        notifyBlockedSenders();
+}
+
+void Connection::notifyWriteQueueCongestion(bool congested)
+{
+    // Senders and the loop race for the transitions, yet the handler must see them alternate
+    std::lock_guard<std::mutex> lock(watermarkMutex_);
+    if (writeQueueCongested_ == congested)
+        return;
+
+    writeQueueCongested_ = congested;
+    watermarkHandler_(congested);
+}
+
+void Connection::notifyBlockedSenders()
+{
+    std::lock_guard<std::mutex> lock(writeQueueMutex_);
+    writeQueueCond_.notify_all();
+}
+
+uint64_t Connection::addLoopExitHandler(std::function<void()> handler)
+{
+    std::lock_guard<std::mutex> lock(loopExitHandlersMutex_);
+    auto handlerId = nextLoopExitHandlerId_++;
+    loopExitHandlers_.emplace(handlerId, std::move(handler));
+    return handlerId;
+}
+
+void Connection::removeLoopExitHandler(uint64_t handlerId)
+{
+    std::lock_guard<std::mutex> lock(loopExitHandlersMutex_);
+    loopExitHandlers_.erase(handlerId);
+}
+
+void Connection::notifyLoopExitHandlers()
+{
+    // Handlers stay registered; their owners remove them once they have been woken up
+    std::lock_guard<std::mutex> lock(loopExitHandlersMutex_);
+    for (auto& handler : loopExitHandlers_)
+        handler.second();
+}
+
+bool Connection::shallQueueOutgoingMessages() const
+{
+    // Nothing to gain from queuing in the loop thread itself, and nobody to drain the queue without the loop
+    return outboundQueue_ != nullptr && isProcessingLoopRunning() && !isInProcessingLoopThread();
+}
+
+void Connection::queueOutgoingMessages(const std::vector<sd_bus_message*>& messages)
+{
+    assert(outboundQueue_ != nullptr);
+
+    // References are handed over to the queue
+    bool wakeUp{};
+    for (auto* message : messages)
+        wakeUp |= outboundQueue_->push(message);
+
+    if (wakeUp)
+        wakeUpProcessingLoop();
+}
+
+void Connection::sendQueuedMessages()
+{
+    if (outboundQueue_ == nullptr || outboundQueue_->empty())
+        return;
+
+    outboundBatch_.clear();
+    outboundQueue_->popAll(outboundBatch_);
+
+    // A failure cannot be reported to the sender anymore, whose send() has returned
+    // long ago, so such a message is dropped like a lost datagram.
+    iface_->sd_bus_send_batch(bus_.get(), outboundBatch_.data(), outboundBatch_.size());
+}
+
 bool Connection::processPendingRequest()
 {
     auto bus = bus_.get();
@@ -263,49 +1091,64 @@ bool Connection::processPendingRequest()
     return r > 0;
 }
 
-bool Connection::waitForNextRequest()
+bool Connection::processPendingRequestBatch(ISdBus::PollData& pollData, std::size_t& processed)
 {
     auto bus = bus_.get();
 
     assert(bus != nullptr);
-    assert(loopExitFd_ != 0);
 
-    ISdBus::PollData sdbusPollData;
-    auto r = iface_->sd_bus_get_poll_data(bus, &sdbusPollData);
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to get bus poll data", -r);
+    auto r = iface_->sd_bus_process_batch(bus, maxMessagesPerBatch_, maxBatchDuration_.count(), &processed, &pollData);
 
-    struct pollfd fds[] = {{sdbusPollData.fd, sdbusPollData.events, 0}, {loopExitFd_, POLLIN, 0}};
-    auto fdsCount = sizeof(fds)/sizeof(fds[0]);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to process bus requests", -r);
 
-    auto timeout = sdbusPollData.timeout_usec == (uint64_t) -1 ? (uint64_t)-1 : (sdbusPollData.timeout_usec+999)/1000;
-    r = poll(fds, fdsCount, timeout);
+    return r > 0;
+}
 
-    if (r < 0 && errno == EINTR)
-        return true; // Try again
+bool Connection::waitForNextRequest(const ISdBus::PollData& pollData)
+{
+    assert(waitBackend_ != nullptr);
 
-    SDBUS_THROW_ERROR_IF(r < 0, "Failed to wait on the bus", -errno);
+    auto events = waitBackend_->wait(pollData);
 
-    if (fds[1].revents & POLLIN)
+    if (events.exitRequested)
     {
         clearExitNotification();
         return false;
     }
 
+    if (events.wakeUpRequested)
+        clearWakeUpNotification();
+
     return true;
 }
 
 std::string Connection::composeSignalMatchFilter( const std::string& objectPath
                                                 , const std::string& interfaceName
-                                                , const std::string& signalName )
+                                                , const std::string& signalName
+                                                , const SignalFilter& filter )
 {
-    std::string filter;
+    std::string match;
 
-    filter += "type='signal',";
-    filter += "interface='" + interfaceName + "',";
-    filter += "member='" + signalName + "',";
-    filter += "path='" + objectPath + "'";
+    match += "type='signal',";
+    match += "interface=" + quoteMatchRuleValue(interfaceName) + ",";
+    match += "member=" + quoteMatchRuleValue(signalName) + ",";
+    // A match rule may contain either of path and path_namespace, not both
+    match += (filter.isPathNamespace() ? "path_namespace=" : "path=") + quoteMatchRuleValue(objectPath);
+
+    for (const auto& argument : filter.getArguments())
+    {
+        SDBUS_THROW_ERROR_IF(argument.first > SignalFilter::MAX_ARGUMENT_INDEX, "Signal argument index out of range", EINVAL);
+        match += ",arg" + std::to_string(argument.first) + "=" + quoteMatchRuleValue(argument.second);
+    }
+    for (const auto& argumentPath : filter.getArgumentPaths())
+    {
+        SDBUS_THROW_ERROR_IF(argumentPath.first > SignalFilter::MAX_ARGUMENT_INDEX, "Signal argument index out of range", EINVAL);
+        match += ",arg" + std::to_string(argumentPath.first) + "path=" + quoteMatchRuleValue(argumentPath.second);
+    }
+    if (!filter.getArgument0Namespace().empty())
+        match += ",arg0namespace=" + quoteMatchRuleValue(filter.getArgument0Namespace());
 
-    return filter;
+    return match;
 }
 
 }}
@@ -332,9 +1175,12 @@ std::unique_ptr<sdbus::IConnection> createSystemBusConnection()
 
 std::unique_ptr<sdbus::IConnection> createSystemBusConnection(const std::string& name)
 {
-    auto conn = createSystemBusConnection();
-    conn->requestName(name);
-    return conn;
+    auto interface = std::make_unique<sdbus::internal::SdBus>();
+    assert(interface != nullptr);
+    return std::make_unique<sdbus::internal::Connection>( sdbus::internal::Connection::BusType::eSystem
+                                                        , std::move(interface)
+                                                        , name
+                                                        , sdbus::internal::Connection::request_name );
 }
 
 std::unique_ptr<sdbus::IConnection> createSessionBusConnection()
@@ -347,9 +1193,39 @@ std::unique_ptr<sdbus::IConnection> createSessionBusConnection()
 
 std::unique_ptr<sdbus::IConnection> createSessionBusConnection(const std::string& name)
 {
-    auto conn = createSessionBusConnection();
-    conn->requestName(name);
-    return conn;
+    auto interface = std::make_unique<sdbus::internal::SdBus>();
+    assert(interface != nullptr);
+    return std::make_unique<sdbus::internal::Connection>( sdbus::internal::Connection::BusType::eSession
+                                                        , std::move(interface)
+                                                        , name
+                                                        , sdbus::internal::Connection::request_name );
+}
+
+std::unique_ptr<sdbus::IConnection> createDirectConnection(const std::string& address)
+{
+    auto interface = std::make_unique<sdbus::internal::SdBus>();
+    assert(interface != nullptr);
+    return std::make_unique<sdbus::internal::Connection>( sdbus::internal::Connection::BusType::eDirect
+                                                        , std::move(interface)
+                                                        , address );
+}
+
+std::unique_ptr<sdbus::IConnection> createDirectConnection(int fd)
+{
+    auto interface = std::make_unique<sdbus::internal::SdBus>();
+    assert(interface != nullptr);
+    return std::make_unique<sdbus::internal::Connection>( sdbus::internal::Connection::BusType::eDirect
+                                                        , std::move(interface)
+                                                        , fd );
+}
+
+std::unique_ptr<sdbus::IConnection> createServerConnection(int fd)
+{
+    auto interface = std::make_unique<sdbus::internal::SdBus>();
+    assert(interface != nullptr);
+    return std::make_unique<sdbus::internal::Connection>( sdbus::internal::Connection::BusType::eServer
+                                                        , std::move(interface)
+                                                        , fd );
 }
 
 }
@@ -31,9 +31,19 @@
 #include "IConnection.h"
 #include "ScopeGuard.h"
 #include "ISdBus.h"
+#include "Dispatcher.h"
+#include "OutboundQueue.h"
+#include "SignalDemultiplexer.h"
+#include "WaitBackend.h"
 #include <systemd/sd-bus.h>
 #include <memory>
+#include <vector>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <map>
 
 namespace sdbus { namespace internal {
 
@@ -45,10 +55,19 @@ namespace sdbus { namespace internal {
         enum class BusType
         {
             eSystem,
-            eSession
+            eSession,
+            eDirect,    // Peer-to-peer client connection, no bus daemon involved
+            eServer     // Peer-to-peer server side of an accepted connection
         };
 
+        // Requests a bus name along with the handshake, instead of in a round trip of its own afterwards
+        struct request_name_t { explicit request_name_t() = default; };
+        static constexpr request_name_t request_name{};
+
         Connection(BusType type, std::unique_ptr<ISdBus>&& interface);
+        Connection(BusType type, std::unique_ptr<ISdBus>&& interface, const std::string& name, request_name_t);
+        Connection(BusType type, std::unique_ptr<ISdBus>&& interface, int fd);
+        Connection(BusType type, std::unique_ptr<ISdBus>&& interface, const std::string& address);
         ~Connection() override;
 
         void requestName(const std::string& name) override;
@@ -56,6 +75,32 @@ namespace sdbus { namespace internal {
         void enterProcessingLoop() override;
         void enterProcessingLoopAsync() override;
         void leaveProcessingLoop() override;
+        PollData getEventLoopPollData() const override;
+        bool processPendingRequest() override;
+        void setProcessingBudget(std::size_t maxMessages, std::chrono::microseconds maxDuration) override;
+        void setDrainReportHandler(drain_report_handler handler) override;
+        void enableMultithreadedDispatch(std::size_t workerCount, dispatch_key_callback keyCallback) override;
+        void enableShardedDispatch(const std::vector<unsigned>& cpus, dispatch_key_callback keyCallback) override;
+        void enableOutboundQueue() override;
+        void enableSignalDemultiplexing() override;
+        void cork() override;
+        void uncork() override;
+        void setWriteQueueLimit(std::size_t maxMessages, OverflowPolicy policy) override;
+        void setWriteQueueWatermarks(std::size_t lowWatermark, std::size_t highWatermark, watermark_handler handler) override;
+        std::size_t getWriteQueueDepth() const override;
+        void setMethodCallTimeout(uint64_t timeout) override;
+        uint64_t getMethodCallTimeout() const override;
+        void setEventLoopBackend(EventLoopBackend backend) override;
+        EventLoopBackend getEventLoopBackend() const override;
+        bool isProcessingLoopRunning() const override;
+        bool isInProcessingLoopThread() const override;
+        bool isDispatchingInCallingThread() const override;
+        void processMatchInstallReplies() override;
+        void wakeUpProcessingLoop() override;
+        uint64_t addLoopExitHandler(std::function<void()> handler) override;
+        void removeLoopExitHandler(uint64_t handlerId) override;
+        bool isDispatchingToWorkers() const override;
+        void dispatchToWorkers(const Message& message, std::function<void()> handler) override;
 
         const ISdBus& getSdBusInterface() const override;
         ISdBus& getSdBusInterface() override;
@@ -74,26 +119,81 @@ namespace sdbus { namespace internal {
                            , const std::string& interfaceName
                            , const std::string& signalName ) const override;
 
-        sd_bus_slot* registerSignalHandler( const std::string& objectPath
-                                          , const std::string& interfaceName
-                                          , const std::string& signalName
-                                          , sd_bus_message_handler_t callback
-                                          , void* userData ) override;
-        void unregisterSignalHandler(sd_bus_slot* handlerCookie) override;
+        SignalSlot registerSignalHandler( const std::string& objectPath
+                                        , const std::string& interfaceName
+                                        , const std::string& signalName
+                                        , const SignalFilter& filter
+                                        , sd_bus_message_handler_t callback
+                                        , sd_bus_message_handler_t installCallback
+                                        , void* userData ) override;
+        bool isConnectedToBusDaemon() const override;
 
     private:
-        sd_bus* openBus(Connection::BusType type);
+        // The match rule shared by all demultiplexed subscriptions to signals of one interface
+        struct InterfaceMatch
+        {
+            Connection* connection_{};
+            std::size_t refCount_{};
+            sd_bus_slot* slot_{};
+            bool adding_{}; // The match is being added outside the lock
+            bool awaitingInstallReply_{}; // Added asynchronously, the daemon's reply to AddMatch is yet to come
+            std::vector<sd_bus_slot*> removedSlots_; // Being released outside the lock, they deliver no signals anymore
+            std::vector<std::pair<sd_bus_message_handler_t, void*>> pendingInstallCallbacks_;
+        };
+
+        using BusFactory = std::function<int(ISdBus&, sd_bus**)>;
+        Connection(std::unique_ptr<ISdBus>&& interface, BusType type, const BusFactory& busFactory, const std::string& name = {});
+        static BusFactory makeBusFactory(BusType type);
+        sd_bus* openBus(const BusFactory& busFactory);
         void finishHandshake(sd_bus* bus);
+        void finishHandshake(sd_bus* bus, const std::string& name);
+        static int sdbus_name_request_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
         static int createProcessingLoopExitDescriptor();
-        static void closeProcessingLoopExitDescriptor(int fd);
-        bool processPendingRequest();
-        bool waitForNextRequest();
+        static int createProcessingLoopWakeUpDescriptor();
+        static void closeProcessingLoopDescriptor(int fd);
+        bool processPendingRequestBatch(ISdBus::PollData& pollData, std::size_t& processed);
+        bool waitForNextRequest(const ISdBus::PollData& pollData);
+        SignalSlot registerDemultiplexedSignalHandler( const std::string& objectPath
+                                                     , const std::string& interfaceName
+                                                     , const std::string& signalName
+                                                     , sd_bus_message_handler_t callback
+                                                     , sd_bus_message_handler_t installCallback
+                                                     , void* userData );
+        void acquireInterfaceMatch(const std::string& interfaceName, sd_bus_message_handler_t installCallback, void* userData);
+        void releaseInterfaceMatch(const std::string& interfaceName, void* userData);
+        void addInterfaceMatch( std::unique_lock<std::mutex>& lock
+                              , const std::string& interfaceName
+                              , InterfaceMatch& match
+                              , bool synchronously );
+        void removeInterfaceMatch(std::unique_lock<std::mutex>& lock, InterfaceMatch& match, sd_bus_slot* slot);
+        int addMatch( sd_bus_slot** slot
+                    , const std::string& rule
+                    , sd_bus_message_handler_t callback
+                    , sd_bus_message_handler_t installCallback
+                    , void* userData
+                    , bool synchronously );
+        static int sdbus_demultiplexed_signal_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_interface_match_installed(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
         static std::string composeSignalMatchFilter( const std::string& objectPath
                                                    , const std::string& interfaceName
-                                                   , const std::string& signalName );
+                                                   , const std::string& signalName
+                                                   , const SignalFilter& filter );
         void notifyProcessingLoopToExit();
         void clearExitNotification();
+        void clearWakeUpNotification();
         void joinWithProcessingLoop();
+        void installSendHook();
+        void dropCork();
+        static int sdbus_send_hook(sd_bus_message *sdbusMessage, void *userData);
+        int applyWriteQueueBackpressure();
+        void waitForWriteQueueToDrain();
+        void updateWriteQueueState();
+        void notifyWriteQueueCongestion(bool congested);
+        void notifyBlockedSenders();
+        void notifyLoopExitHandlers();
+        bool shallQueueOutgoingMessages() const;
+        void queueOutgoingMessages(const std::vector<sd_bus_message*>& messages);
+        void sendQueuedMessages();
 
     private:
         std::unique_ptr<ISdBus> iface_;
@@ -103,8 +203,45 @@ namespace sdbus { namespace internal {
                                                                                 }};
         BusType busType_;
 
+        std::size_t maxMessagesPerBatch_{1};
+        std::chrono::microseconds maxBatchDuration_{};
+        drain_report_handler drainReportHandler_;
+
+        std::unique_ptr<Dispatcher> dispatcher_;
+        dispatch_key_callback dispatchKeyCallback_;
+
+        std::atomic<bool> sendHookInstalled_{};
+        const uint64_t corkKey_; // Unlike the address, never reused by a later connection
+        std::unique_ptr<OutboundQueue> outboundQueue_;
+        std::vector<sd_bus_message*> outboundBatch_; // Used by the loop thread only, kept to reuse its capacity
+
+        std::unique_ptr<SignalDemultiplexer> signalDemultiplexer_;
+        std::map<std::string, InterfaceMatch> interfaceMatches_; // Entries stay in place, their addresses are match userdata
+        std::mutex interfaceMatchesMutex_; // Never held across calls into sd-bus
+        std::condition_variable interfaceMatchesCond_;
+
+        std::size_t writeQueueLimit_{};
+        OverflowPolicy overflowPolicy_{OverflowPolicy::eBlock};
+        std::size_t lowWatermark_{};
+        std::size_t highWatermark_{};
+        watermark_handler watermarkHandler_;
+        std::atomic<bool> writeQueueCongested_{};
+        std::mutex watermarkMutex_;
+        std::atomic<std::size_t> blockedSenders_{};
+        std::mutex writeQueueMutex_;
+        std::condition_variable writeQueueCond_;
+
+        std::unique_ptr<IWaitBackend> waitBackend_;
+        EventLoopBackend waitBackendType_{EventLoopBackend::ePoll};
+
+        std::map<uint64_t, std::function<void()>> loopExitHandlers_;
+        uint64_t nextLoopExitHandlerId_{};
+        std::mutex loopExitHandlersMutex_;
+
         std::thread asyncLoopThread_;
+        std::atomic<std::thread::id> loopThreadId_{};
         int loopExitFd_{-1};
+        int loopWakeUpFd_{-1};
     };
 
 }}
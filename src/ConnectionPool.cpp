@@ -0,0 +1,83 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file ConnectionPool.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConnectionPool.h"
+#include "MessageUtils.h"
+#include <sdbus-c++/IConnection.h>
+#include <sdbus-c++/Message.h>
+#include <sdbus-c++/Error.h>
+#include <cassert>
+
+namespace sdbus { namespace internal {
+
+ConnectionPool::ConnectionPool(std::vector<std::unique_ptr<sdbus::internal::IConnection>>&& connections)
+    : connections_(std::move(connections))
+{
+    SDBUS_THROW_ERROR_IF(connections_.empty(), "Connection pool must contain at least one connection", EINVAL);
+
+    for (auto& connection : connections_)
+    {
+        connectionsBySdBus_.emplace(&connection->getSdBusInterface(), connection.get());
+        connection->enterProcessingLoopAsync();
+    }
+}
+
+std::size_t ConnectionPool::getSize() const
+{
+    return connections_.size();
+}
+
+sdbus::internal::IConnection& ConnectionPool::getConnection(std::size_t index)
+{
+    assert(index < connections_.size());
+    return *connections_[index];
+}
+
+sdbus::internal::IConnection* ConnectionPool::findConnectionOf(const Message& message)
+{
+    auto it = connectionsBySdBus_.find(getSdBusInterfaceOf(message));
+    return it != connectionsBySdBus_.end() ? it->second : nullptr;
+}
+
+}}
+
+namespace sdbus {
+
+std::unique_ptr<sdbus::IConnectionPool> createConnectionPool(std::size_t size)
+{
+    std::vector<std::unique_ptr<sdbus::internal::IConnection>> connections;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        auto connection = sdbus::createConnection();
+        auto* sdbusConnection = dynamic_cast<sdbus::internal::IConnection*>(connection.get());
+        assert(sdbusConnection != nullptr);
+        connection.release();
+        connections.emplace_back(sdbusConnection);
+    }
+
+    return std::make_unique<sdbus::internal::ConnectionPool>(std::move(connections));
+}
+
+}
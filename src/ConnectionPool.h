@@ -0,0 +1,57 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file ConnectionPool.h
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_CONNECTIONPOOL_H_
+#define SDBUS_CXX_INTERNAL_CONNECTIONPOOL_H_
+
+#include <sdbus-c++/IConnectionPool.h>
+#include "IConnection.h"
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstddef>
+
+namespace sdbus { namespace internal {
+
+    class ConnectionPool
+        : public sdbus::IConnectionPool
+    {
+    public:
+        explicit ConnectionPool(std::vector<std::unique_ptr<sdbus::internal::IConnection>>&& connections);
+
+        std::size_t getSize() const override;
+
+        sdbus::internal::IConnection& getConnection(std::size_t index);
+        sdbus::internal::IConnection* findConnectionOf(const Message& message);
+
+    private:
+        std::vector<std::unique_ptr<sdbus::internal::IConnection>> connections_;
+        // Each connection has its own sd-bus interface instance, which every message created on it refers to
+        std::unordered_map<const sdbus::internal::ISdBus*, sdbus::internal::IConnection*> connectionsBySdBus_;
+    };
+
+}}
+
+#endif /* SDBUS_CXX_INTERNAL_CONNECTIONPOOL_H_ */
@@ -61,6 +61,9 @@ MethodRegistrator::~MethodRegistrator() noexcept(false) // since C++11, destruct
         object_.registerMethod(interfaceName_, methodName_, inputSignature_, outputSignature_, std::move(asyncCallback_), flags_);
     else
         SDBUS_THROW_ERROR("Method handler not specified when registering a DBus method", EINVAL);
+
+    if (executor_ != nullptr)
+        object_.setMethodExecutor(interfaceName_, methodName_, *executor_);
 }
 
 SignalRegistrator::SignalRegistrator(IObject& object, const std::string& signalName)
@@ -206,7 +209,7 @@ MethodInvoker::~MethodInvoker() noexcept(false) // since C++11, destructors must
     // Therefore, we can allow callMethod() to throw even if we are in the destructor.
     // Bottomline is, to be on the safe side, the caller must take care of catching and reacting
     // to the exception thrown from here if the caller is a destructor itself.
-    objectProxy_.callMethod(method_);
+    objectProxy_.callMethod(method_, timeout_);
 }
 
 }
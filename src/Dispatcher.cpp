@@ -0,0 +1,145 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file Dispatcher.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Dispatcher.h"
+#include <sdbus-c++/Error.h>
+#include <cassert>
+#include <pthread.h>
+#include <sched.h>
+
+namespace sdbus { namespace internal {
+
+Dispatcher::Dispatcher(std::size_t workerCount)
+{
+    SDBUS_THROW_ERROR_IF(workerCount == 0, "Invalid number of dispatch workers", EINVAL);
+
+    startWorkers(workerCount);
+}
+
+Dispatcher::Dispatcher(const std::vector<unsigned>& workerCpus)
+{
+    SDBUS_THROW_ERROR_IF(workerCpus.empty(), "Invalid number of dispatch workers", EINVAL);
+
+    startWorkers(workerCpus.size());
+
+    try
+    {
+        for (std::size_t i = 0; i < workers_.size(); ++i)
+            pinWorker(*workers_[i], workerCpus[i]);
+    }
+    catch (...)
+    {
+        stopWorkers();
+        throw;
+    }
+}
+
+Dispatcher::~Dispatcher()
+{
+    stopWorkers();
+}
+
+void Dispatcher::startWorkers(std::size_t workerCount)
+{
+    workers_.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        auto worker = std::make_unique<Worker>();
+        worker->thread_ = std::thread([&worker = *worker](){ run(worker); });
+        workers_.push_back(std::move(worker));
+    }
+}
+
+void Dispatcher::stopWorkers()
+{
+    // Workers finish all tasks already posted before they exit
+    for (auto& worker : workers_)
+    {
+        std::unique_lock<std::mutex> lock(worker->mutex_);
+        worker->exit_ = true;
+        lock.unlock();
+        worker->cond_.notify_one();
+    }
+
+    for (auto& worker : workers_)
+        worker->thread_.join();
+}
+
+void Dispatcher::post(std::size_t key, std::function<void()> task)
+{
+    assert(task);
+
+    auto& worker = *workers_[key % workers_.size()];
+
+    std::unique_lock<std::mutex> lock(worker.mutex_);
+    worker.tasks_.push_back(std::move(task));
+    lock.unlock();
+    worker.cond_.notify_one();
+}
+
+void Dispatcher::pinWorker(Worker& worker, unsigned cpu)
+{
+    SDBUS_THROW_ERROR_IF(cpu >= CPU_SETSIZE, "Invalid CPU for dispatch worker", EINVAL);
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+
+    auto r = pthread_setaffinity_np(worker.thread_.native_handle(), sizeof(cpuSet), &cpuSet);
+    SDBUS_THROW_ERROR_IF(r != 0, "Failed to pin dispatch worker to CPU", r);
+}
+
+std::size_t Dispatcher::getWorkerCount() const
+{
+    return workers_.size();
+}
+
+void Dispatcher::run(Worker& worker)
+{
+    std::unique_lock<std::mutex> lock(worker.mutex_);
+
+    while (true)
+    {
+        worker.cond_.wait(lock, [&worker](){ return !worker.tasks_.empty() || worker.exit_; });
+        if (worker.tasks_.empty())
+            break; // Exit requested and nothing more to do
+
+        auto task = std::move(worker.tasks_.front());
+        worker.tasks_.pop_front();
+
+        lock.unlock();
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            // Tasks handle their failures themselves; a stray exception must not take the worker down
+        }
+        lock.lock();
+    }
+}
+
+}}
@@ -0,0 +1,74 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file Dispatcher.h
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_DISPATCHER_H_
+#define SDBUS_CXX_INTERNAL_DISPATCHER_H_
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+namespace sdbus { namespace internal {
+
+    // Runs posted tasks in a fixed set of worker threads. Tasks posted with the same key
+    // always end up in the same worker, so they are executed sequentially in posting order.
+    // Workers may be pinned to CPUs, one worker per given CPU.
+    class Dispatcher
+    {
+    public:
+        explicit Dispatcher(std::size_t workerCount);
+        explicit Dispatcher(const std::vector<unsigned>& workerCpus);
+        ~Dispatcher();
+
+        void post(std::size_t key, std::function<void()> task);
+        std::size_t getWorkerCount() const;
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex_;
+            std::condition_variable cond_;
+            std::deque<std::function<void()>> tasks_;
+            bool exit_{};
+            std::thread thread_;
+        };
+
+        void startWorkers(std::size_t workerCount);
+        void stopWorkers();
+        static void pinWorker(Worker& worker, unsigned cpu);
+        static void run(Worker& worker);
+
+    private:
+        std::vector<std::unique_ptr<Worker>> workers_;
+    };
+
+}}
+
+#endif /* SDBUS_CXX_INTERNAL_DISPATCHER_H_ */
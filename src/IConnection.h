@@ -29,9 +29,11 @@
 #include <systemd/sd-bus.h>
 #include <string>
 #include <memory>
+#include <functional>
 
 // Forward declaration
 namespace sdbus {
+    class Message;
     class MethodCall;
     class AsyncMethodCall;
     class MethodReply;
@@ -39,11 +41,15 @@ namespace sdbus {
     namespace internal {
         class ISdBus;
     }
+    class SignalFilter;
 }
 
 namespace sdbus {
 namespace internal {
 
+    // Owns a signal subscription; destroying it unsubscribes the handler
+    using SignalSlot = std::unique_ptr<void, std::function<void(void*)>>;
+
     class IConnection
     {
     public:
@@ -65,15 +71,38 @@ namespace internal {
                                    , const std::string& interfaceName
                                    , const std::string& signalName ) const = 0;
 
-        virtual sd_bus_slot* registerSignalHandler( const std::string& objectPath
-                                                  , const std::string& interfaceName
-                                                  , const std::string& signalName
-                                                  , sd_bus_message_handler_t callback
-                                                  , void* userData ) = 0;
-        virtual void unregisterSignalHandler(sd_bus_slot* handlerCookie) = 0;
+        // The match is installed asynchronously where possible; installCallback gets the bus daemon's reply
+        // to AddMatch once the bus is processed. Where it is not (from within message dispatch), the match
+        // is installed synchronously and a refusal is thrown right away.
+        virtual SignalSlot registerSignalHandler( const std::string& objectPath
+                                                , const std::string& interfaceName
+                                                , const std::string& signalName
+                                                , const SignalFilter& filter
+                                                , sd_bus_message_handler_t callback
+                                                , sd_bus_message_handler_t installCallback
+                                                , void* userData ) = 0;
+        virtual bool isConnectedToBusDaemon() const = 0;
+        // True in the processing loop thread, or within processPendingRequest() of an external loop
+        virtual bool isDispatchingInCallingThread() const = 0;
+        // To be called once a call sent after the AddMatch calls has returned: processes the bus, unless
+        // the processing loop does, so that the install callbacks have got the daemon's replies
+        virtual void processMatchInstallReplies() = 0;
 
         virtual void enterProcessingLoopAsync() = 0;
         virtual void leaveProcessingLoop() = 0;
+        virtual bool isProcessingLoopRunning() const = 0;
+        virtual bool isInProcessingLoopThread() const = 0;
+        virtual void wakeUpProcessingLoop() = 0;
+        // The handler runs in the loop thread once the processing loop exits; to fail callers still waiting for it
+        virtual uint64_t addLoopExitHandler(std::function<void()> handler) = 0;
+        virtual void removeLoopExitHandler(uint64_t handlerId) = 0;
+        virtual uint64_t getMethodCallTimeout() const = 0;
+
+        virtual void cork() = 0;
+        virtual void uncork() = 0;
+
+        virtual bool isDispatchingToWorkers() const = 0;
+        virtual void dispatchToWorkers(const Message& message, std::function<void()> handler) = 0;
 
         virtual ~IConnection() = default;
     };
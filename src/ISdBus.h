@@ -28,6 +28,7 @@
 #define SDBUS_CXX_ISDBUS_H
 
 #include <systemd/sd-bus.h>
+#include <functional>
 
 namespace sdbus { namespace internal {
 
@@ -44,7 +45,14 @@ namespace sdbus { namespace internal {
         virtual sd_bus_message* sd_bus_message_ref(sd_bus_message *m) = 0;
         virtual sd_bus_message* sd_bus_message_unref(sd_bus_message *m) = 0;
 
+        // The hook may take over messages sent with no explicit bus and no cookie requested; it returns
+        // a positive value if it did, 0 if the message shall be sent right away, or a negative errno
+        typedef int (*sd_bus_send_hook_t)(sd_bus_message *m, void *userdata);
+
         virtual int sd_bus_send(sd_bus *bus, sd_bus_message *m, uint64_t *cookie) = 0;
+        virtual void sd_bus_set_send_hook(sd_bus_send_hook_t hook, void *userdata) = 0;
+        // Sends all messages, even if some fail, and unrefs them; returns the first error, if any
+        virtual int sd_bus_send_batch(sd_bus *bus, sd_bus_message **messages, size_t count) = 0;
         virtual int sd_bus_call(sd_bus *bus, sd_bus_message *m, uint64_t usec, sd_bus_error *ret_error, sd_bus_message **reply) = 0;
         virtual int sd_bus_call_async(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec) = 0;
 
@@ -55,14 +63,31 @@ namespace sdbus { namespace internal {
 
         virtual int sd_bus_open_user(sd_bus **ret) = 0;
         virtual int sd_bus_open_system(sd_bus **ret) = 0;
+        virtual int sd_bus_open_direct(sd_bus **ret, const char *address) = 0;
+        virtual int sd_bus_open_direct(sd_bus **ret, int fd) = 0;
+        virtual int sd_bus_open_server(sd_bus **ret, int fd) = 0;
         virtual int sd_bus_request_name(sd_bus *bus, const char *name, uint64_t flags) = 0;
+        virtual int sd_bus_request_name_async(sd_bus *bus, sd_bus_slot **slot, const char *name, uint64_t flags, sd_bus_message_handler_t callback, void *userdata) = 0;
         virtual int sd_bus_release_name(sd_bus *bus, const char *name) = 0;
         virtual int sd_bus_add_object_vtable(sd_bus *bus, sd_bus_slot **slot, const char *path, const char *interface, const sd_bus_vtable *vtable, void *userdata) = 0;
         virtual int sd_bus_add_match(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, void *userdata) = 0;
+        virtual int sd_bus_add_match_async(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata) = 0;
         virtual sd_bus_slot* sd_bus_slot_unref(sd_bus_slot *slot) = 0;
 
         virtual int sd_bus_process(sd_bus *bus, sd_bus_message **r) = 0;
+        // To be called from callbacks of sd_bus_process(): the task runs once the processing is over
+        // and the bus is unlocked, still before sd_bus_process() returns
+        virtual void sd_bus_defer_until_processed(std::function<void()> task) = 0;
+        // Does not lock the bus while waiting; meant for a bus not shared with other threads yet
+        virtual int sd_bus_wait(sd_bus *bus, uint64_t timeout_usec) = 0;
         virtual int sd_bus_get_poll_data(sd_bus *bus, PollData* data) = 0;
+        virtual sd_bus_message* sd_bus_get_current_message(sd_bus *bus) = 0;
+        virtual int sd_bus_process_batch(sd_bus *bus, size_t max_messages, uint64_t max_usec, size_t *processed, PollData* data) = 0;
+
+        virtual int sd_bus_set_method_call_timeout(sd_bus *bus, uint64_t usec) = 0;
+        virtual int sd_bus_get_method_call_timeout(sd_bus *bus, uint64_t *ret) = 0;
+
+        virtual int sd_bus_get_n_queued_write(sd_bus *bus, uint64_t *ret) = 0;
 
         virtual int sd_bus_flush(sd_bus *bus) = 0;
         virtual sd_bus *sd_bus_flush_close_unref(sd_bus *bus) = 0;
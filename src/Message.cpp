@@ -41,12 +41,8 @@ Message::Message(internal::ISdBus* sdbus) noexcept
 }
 
 Message::Message(void *msg, internal::ISdBus* sdbus) noexcept
-    : msg_(msg)
-    , sdbus_(sdbus)
+    : Message(sdbus->sd_bus_message_ref((sd_bus_message*)msg), sdbus, adopt_message)
 {
-    assert(msg_ != nullptr);
-    assert(sdbus_ != nullptr);
-    sdbus_->sd_bus_message_ref((sd_bus_message*)msg_);
 }
 
 Message::Message(void *msg, internal::ISdBus* sdbus, adopt_message_t) noexcept
@@ -55,26 +51,16 @@ Message::Message(void *msg, internal::ISdBus* sdbus, adopt_message_t) noexcept
 {
     assert(msg_ != nullptr);
     assert(sdbus_ != nullptr);
-}
 
-Message::Message(const Message& other) noexcept
-{
-    *this = other;
+    // sd-bus message reference counting also touches the reference count of the bus
+    // the message belongs to, so it must go through the synchronized ISdBus layer.
+    // We therefore take a single sd-bus reference per message and share it among copies.
+    msgRef_ = std::shared_ptr<void>(msg_, [sdbus](void* msg){ sdbus->sd_bus_message_unref((sd_bus_message*)msg); });
 }
 
-Message& Message::operator=(const Message& other) noexcept
-{
-    if (msg_)
-        sdbus_->sd_bus_message_unref((sd_bus_message*)msg_);
-
-    msg_ = other.msg_;
-    sdbus_ = other.sdbus_;
-    ok_ = other.ok_;
-
-    sdbus_->sd_bus_message_ref((sd_bus_message*)msg_);
+Message::Message(const Message& other) noexcept = default;
 
-    return *this;
-}
+Message& Message::operator=(const Message& other) noexcept = default;
 
 Message::Message(Message&& other) noexcept
 {
@@ -83,24 +69,18 @@ Message::Message(Message&& other) noexcept
 
 Message& Message::operator=(Message&& other) noexcept
 {
-    if (msg_)
-        sdbus_->sd_bus_message_unref((sd_bus_message*)msg_);
-
     msg_ = other.msg_;
     other.msg_ = nullptr;
     sdbus_ = other.sdbus_;
     other.sdbus_ = nullptr;
+    msgRef_ = std::move(other.msgRef_);
     ok_ = other.ok_;
     other.ok_ = true;
 
     return *this;
 }
 
-Message::~Message()
-{
-    if (msg_)
-        sdbus_->sd_bus_message_unref((sd_bus_message*)msg_);
-}
+Message::~Message() = default;
 
 Message& Message::operator<<(bool item)
 {
@@ -386,7 +366,12 @@ Message& Message::operator>>(Signature &item)
 
 Message& Message::openContainer(const std::string& signature)
 {
-    auto r = sd_bus_message_open_container((sd_bus_message*)msg_, SD_BUS_TYPE_ARRAY, signature.c_str());
+    return openContainer(signature.c_str());
+}
+
+Message& Message::openContainer(const char* signature)
+{
+    auto r = sd_bus_message_open_container((sd_bus_message*)msg_, SD_BUS_TYPE_ARRAY, signature);
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to open a container", -r);
 
     return *this;
@@ -402,7 +387,12 @@ Message& Message::closeContainer()
 
 Message& Message::openDictEntry(const std::string& signature)
 {
-    auto r = sd_bus_message_open_container((sd_bus_message*)msg_, SD_BUS_TYPE_DICT_ENTRY, signature.c_str());
+    return openDictEntry(signature.c_str());
+}
+
+Message& Message::openDictEntry(const char* signature)
+{
+    auto r = sd_bus_message_open_container((sd_bus_message*)msg_, SD_BUS_TYPE_DICT_ENTRY, signature);
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to open a dictionary entry", -r);
 
     return *this;
@@ -418,7 +408,12 @@ Message& Message::closeDictEntry()
 
 Message& Message::openVariant(const std::string& signature)
 {
-    auto r = sd_bus_message_open_container((sd_bus_message*)msg_, SD_BUS_TYPE_VARIANT, signature.c_str());
+    return openVariant(signature.c_str());
+}
+
+Message& Message::openVariant(const char* signature)
+{
+    auto r = sd_bus_message_open_container((sd_bus_message*)msg_, SD_BUS_TYPE_VARIANT, signature);
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to open a variant", -r);
 
     return *this;
@@ -434,7 +429,12 @@ Message& Message::closeVariant()
 
 Message& Message::openStruct(const std::string& signature)
 {
-    auto r = sd_bus_message_open_container((sd_bus_message*)msg_, SD_BUS_TYPE_STRUCT, signature.c_str());
+    return openStruct(signature.c_str());
+}
+
+Message& Message::openStruct(const char* signature)
+{
+    auto r = sd_bus_message_open_container((sd_bus_message*)msg_, SD_BUS_TYPE_STRUCT, signature);
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to open a struct", -r);
 
     return *this;
@@ -451,7 +451,12 @@ Message& Message::closeStruct()
 
 Message& Message::enterContainer(const std::string& signature)
 {
-    auto r = sd_bus_message_enter_container((sd_bus_message*)msg_, SD_BUS_TYPE_ARRAY, signature.c_str());
+    return enterContainer(signature.c_str());
+}
+
+Message& Message::enterContainer(const char* signature)
+{
+    auto r = sd_bus_message_enter_container((sd_bus_message*)msg_, SD_BUS_TYPE_ARRAY, signature);
     if (r == 0)
         ok_ = false;
 
@@ -470,7 +475,12 @@ Message& Message::exitContainer()
 
 Message& Message::enterDictEntry(const std::string& signature)
 {
-    auto r = sd_bus_message_enter_container((sd_bus_message*)msg_, SD_BUS_TYPE_DICT_ENTRY, signature.c_str());
+    return enterDictEntry(signature.c_str());
+}
+
+Message& Message::enterDictEntry(const char* signature)
+{
+    auto r = sd_bus_message_enter_container((sd_bus_message*)msg_, SD_BUS_TYPE_DICT_ENTRY, signature);
     if (r == 0)
         ok_ = false;
 
@@ -489,7 +499,12 @@ Message& Message::exitDictEntry()
 
 Message& Message::enterVariant(const std::string& signature)
 {
-    auto r = sd_bus_message_enter_container((sd_bus_message*)msg_, SD_BUS_TYPE_VARIANT, signature.c_str());
+    return enterVariant(signature.c_str());
+}
+
+Message& Message::enterVariant(const char* signature)
+{
+    auto r = sd_bus_message_enter_container((sd_bus_message*)msg_, SD_BUS_TYPE_VARIANT, signature);
     if (r == 0)
         ok_ = false;
 
@@ -508,7 +523,12 @@ Message& Message::exitVariant()
 
 Message& Message::enterStruct(const std::string& signature)
 {
-    auto r = sd_bus_message_enter_container((sd_bus_message*)msg_, SD_BUS_TYPE_STRUCT, signature.c_str());
+    return enterStruct(signature.c_str());
+}
+
+Message& Message::enterStruct(const char* signature)
+{
+    auto r = sd_bus_message_enter_container((sd_bus_message*)msg_, SD_BUS_TYPE_STRUCT, signature);
     if (r == 0)
         ok_ = false;
 
@@ -526,6 +546,28 @@ Message& Message::exitStruct()
 }
 
 
+Message& Message::appendArray(char type, const void* ptr, std::size_t size)
+{
+    auto r = sd_bus_message_append_array((sd_bus_message*)msg_, type, ptr, size);
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to serialize an array", -r);
+
+    return *this;
+}
+
+bool Message::readArray(char type, const void*& ptr, std::size_t& size)
+{
+    auto r = sd_bus_message_read_array((sd_bus_message*)msg_, type, &ptr, &size);
+    if (r == -EOPNOTSUPP)
+        return false;
+    if (r == 0)
+        ok_ = false;
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to deserialize an array", -r);
+
+    return true;
+}
+
+
 Message::operator bool() const
 {
     return ok_;
@@ -566,6 +608,12 @@ std::string Message::getMemberName() const
     return sd_bus_message_get_member((sd_bus_message*)msg_);
 }
 
+std::string Message::getPath() const
+{
+    auto path = sd_bus_message_get_path((sd_bus_message*)msg_);
+    return path != nullptr ? path : "";
+}
+
 void Message::peekType(std::string& type, std::string& contents) const
 {
     char typeSig;
@@ -599,21 +647,21 @@ bool MethodCall::doesntExpectReply() const
     return r > 0 ? false : true;
 }
 
-MethodReply MethodCall::send() const
+MethodReply MethodCall::send(uint64_t timeout) const
 {
     if (!doesntExpectReply())
-        return sendWithReply();
+        return sendWithReply(timeout);
     else
         return sendWithNoReply();
 }
 
-MethodReply MethodCall::sendWithReply() const
+MethodReply MethodCall::sendWithReply(uint64_t timeout) const
 {
     sd_bus_error sdbusError = SD_BUS_ERROR_NULL;
     SCOPE_EXIT{ sd_bus_error_free(&sdbusError); };
 
     sd_bus_message* sdbusReply{};
-    auto r = sdbus_->sd_bus_call(nullptr, (sd_bus_message*)msg_, 0, &sdbusError, &sdbusReply);
+    auto r = sdbus_->sd_bus_call(nullptr, (sd_bus_message*)msg_, timeout, &sdbusError, &sdbusReply);
 
     if (sd_bus_error_is_set(&sdbusError))
         throw sdbus::Error(sdbusError.name, sdbusError.message);
@@ -658,9 +706,10 @@ AsyncMethodCall::AsyncMethodCall(MethodCall&& call) noexcept
 {
 }
 
-void AsyncMethodCall::send(void* callback, void* userData) const
+void AsyncMethodCall::send(void* callback, void* userData, uint64_t timeout, void** slot) const
 {
-    auto r = sdbus_->sd_bus_call_async(nullptr, nullptr, (sd_bus_message*)msg_, (sd_bus_message_handler_t)callback, userData, 0);
+    // The slot is stored while the bus is still locked, i.e. before the reply can be processed
+    auto r = sdbus_->sd_bus_call_async(nullptr, (sd_bus_slot**)slot, (sd_bus_message*)msg_, (sd_bus_message_handler_t)callback, userData, timeout);
     SDBUS_THROW_ERROR_IF(r < 0, "Failed to call method asynchronously", -r);
 }
 
@@ -687,7 +736,8 @@ Message createPlainMessage()
 
     thread_local struct BusReferenceKeeper
     {
-        BusReferenceKeeper(sd_bus* bus) : bus_(bus) {}
+        // Plain messages take and drop references to the bus, the keeper must hold a reference of its own
+        BusReferenceKeeper(sd_bus* bus) : bus_(sd_bus_ref(bus)) {}
         ~BusReferenceKeeper() { sd_bus_unref(bus_); }
         sd_bus* bus_{};
     } busReferenceKeeper{bus};
@@ -701,4 +751,13 @@ Message createPlainMessage()
     return Message{sdbusMsg, &sdbus, adopt_message};
 }
 
+namespace internal {
+
+ISdBus* getSdBusInterfaceOf(const Message& message) noexcept
+{
+    return message.sdbus_;
+}
+
+}
+
 }
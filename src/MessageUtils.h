@@ -31,6 +31,12 @@
 namespace sdbus
 {
     Message createPlainMessage();
+
+namespace internal
+{
+    // Tells which sd-bus interface, and thus which connection, the message was created on
+    ISdBus* getSdBusInterfaceOf(const Message& message) noexcept;
+}
 }
 
 #endif /* SDBUS_CXX_INTERNAL_MESSAGEUTILS_H_ */
@@ -29,19 +29,66 @@
 #include <sdbus-c++/Error.h>
 #include <sdbus-c++/MethodResult.h>
 #include <sdbus-c++/Flags.h>
+#include <sdbus-c++/IExecutor.h>
 #include "IConnection.h"
 #include "VTableUtils.h"
 #include <systemd/sd-bus.h>
 #include <utility>
 #include <cassert>
+#include <cstdint>
+#include <exception>
+#include <time.h>
 
 namespace sdbus { namespace internal {
 
+namespace {
+    uint64_t now()
+    {
+        struct timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+    }
+
+    // sd-bus attaches receive timestamps to messages only on some transports (none of the socket ones).
+    // Without one, we take the moment the loop dispatches the message, i.e. just after it has read it.
+    uint64_t receiveTimestampOf(sd_bus_message* sdbusMessage)
+    {
+        uint64_t usec{};
+        auto r = sd_bus_message_get_monotonic_usec(sdbusMessage, &usec);
+        return r >= 0 && usec != 0 ? usec : now();
+    }
+
+    // For handlers run out of the sd-bus callback, which have to send the error reply on their own
+    void sendErrorReply(const MethodCall& message, const sdbus::Error& error) noexcept
+    {
+        try
+        {
+            if (!message.doesntExpectReply())
+                message.createErrorReply(error).send();
+        }
+        catch (...)
+        {
+            // There is no one left to report the failure to
+        }
+    }
+}
+
 Object::Object(sdbus::internal::IConnection& connection, std::string objectPath)
     : connection_(connection), objectPath_(std::move(objectPath))
 {
 }
 
+Object::~Object()
+{
+    // Stop incoming calls first, then wait for the handlers of calls already handed over to other
+    // threads, as they use the method data of this object
+    for (auto& item : interfaces_)
+        item.second.slot_.reset();
+
+    std::unique_lock<std::mutex> lock(methodJobsMutex_);
+    methodJobsDone_.wait(lock, [this](){ return methodJobsInFlight_ == 0; });
+}
+
 void Object::registerMethod( const std::string& interfaceName
                            , const std::string& methodName
                            , const std::string& inputSignature
@@ -59,7 +106,7 @@ void Object::registerMethod( const std::string& interfaceName
     };
 
     auto& interface = interfaces_[interfaceName];
-    InterfaceData::MethodData methodData{inputSignature, outputSignature, std::move(syncCallback), flags};
+    InterfaceData::MethodData methodData{this, inputSignature, outputSignature, std::move(syncCallback), flags};
     auto inserted = interface.methods_.emplace(methodName, std::move(methodData)).second;
 
     SDBUS_THROW_ERROR_IF(!inserted, "Failed to register method: method already exists", EINVAL);
@@ -81,7 +128,7 @@ void Object::registerMethod( const std::string& interfaceName
     };
 
     auto& interface = interfaces_[interfaceName];
-    InterfaceData::MethodData methodData{inputSignature, outputSignature, std::move(asyncCallback), flags};
+    InterfaceData::MethodData methodData{this, inputSignature, outputSignature, std::move(asyncCallback), flags};
     auto inserted = interface.methods_.emplace(methodName, std::move(methodData)).second;
 
     SDBUS_THROW_ERROR_IF(!inserted, "Failed to register method: method already exists", EINVAL);
@@ -125,7 +172,7 @@ void Object::registerProperty( const std::string& interfaceName
 
     auto& interface = interfaces_[interfaceName];
 
-    InterfaceData::PropertyData propertyData{signature, std::move(getCallback), std::move(setCallback), flags};
+    InterfaceData::PropertyData propertyData{this, signature, std::move(getCallback), std::move(setCallback), flags};
     auto inserted = interface.properties_.emplace(propertyName, std::move(propertyData)).second;
 
     SDBUS_THROW_ERROR_IF(!inserted, "Failed to register property: property already exists", EINVAL);
@@ -137,8 +184,54 @@ void Object::setInterfaceFlags(const std::string& interfaceName, Flags flags)
     interface.flags_ = flags;
 }
 
+void Object::setMaxMethodCallQueueAge(const std::string& interfaceName, uint64_t maxQueueAge)
+{
+    SDBUS_THROW_ERROR_IF(registrationFinished_, "Cannot set method call queue age after registration is finished", EBUSY);
+
+    auto& interface = interfaces_[interfaceName];
+    interface.maxQueueAge_ = maxQueueAge;
+}
+
+void Object::setMaxMethodCallQueueAge( const std::string& interfaceName
+                                     , const std::string& methodName
+                                     , uint64_t maxQueueAge )
+{
+    SDBUS_THROW_ERROR_IF(registrationFinished_, "Cannot set method call queue age after registration is finished", EBUSY);
+
+    auto& interface = interfaces_[interfaceName];
+    interface.methodMaxQueueAges_[methodName] = maxQueueAge;
+}
+
+uint64_t Object::getExpiredMethodCallCount() const
+{
+    return expiredMethodCalls_.load(std::memory_order_relaxed);
+}
+
+void Object::setMethodExecutor(const std::string& interfaceName, IExecutor& executor)
+{
+    auto& interface = interfaces_[interfaceName];
+    interface.executor_ = &executor;
+}
+
+void Object::setMethodExecutor( const std::string& interfaceName
+                              , const std::string& methodName
+                              , IExecutor& executor )
+{
+    auto& interface = interfaces_[interfaceName];
+    interface.methodExecutors_[methodName] = &executor;
+}
+
 void Object::finishRegistration()
 {
+    for (auto& item : interfaces_)
+    {
+        auto& interfaceData = item.second;
+
+        resolveMaxQueueAges(interfaceData);
+        resolveExecutors(interfaceData);
+        checkMaxQueueAges(interfaceData);
+    }
+
     for (auto& item : interfaces_)
     {
         const auto& interfaceName = item.first;
@@ -147,6 +240,8 @@ void Object::finishRegistration()
         const auto& vtable = createInterfaceVTable(interfaceData);
         activateInterfaceVTable(interfaceName, interfaceData, vtable);
     }
+
+    registrationFinished_ = true;
 }
 
 sdbus::Signal Object::createSignal(const std::string& interfaceName, const std::string& signalName)
@@ -159,7 +254,78 @@ void Object::emitSignal(const sdbus::Signal& message)
     message.send();
 }
 
-const std::vector<sd_bus_vtable>& Object::createInterfaceVTable(InterfaceData& interfaceData)
+void Object::cork()
+{
+    connection_.cork();
+}
+
+void Object::uncork()
+{
+    connection_.uncork();
+}
+
+void Object::resolveMaxQueueAges(InterfaceData& interfaceData)
+{
+    for (auto& item : interfaceData.methods_)
+    {
+        const auto& methodName = item.first;
+        auto& methodData = item.second;
+
+        auto it = interfaceData.methodMaxQueueAges_.find(methodName);
+        methodData.maxQueueAge_ = it != interfaceData.methodMaxQueueAges_.end() ? it->second : interfaceData.maxQueueAge_;
+    }
+}
+
+void Object::resolveExecutors(InterfaceData& interfaceData)
+{
+    for (auto& item : interfaceData.methods_)
+    {
+        const auto& methodName = item.first;
+        auto& methodData = item.second;
+
+        auto it = interfaceData.methodExecutors_.find(methodName);
+        methodData.executor_ = it != interfaceData.methodExecutors_.end() ? it->second : interfaceData.executor_;
+    }
+}
+
+void Object::checkMaxQueueAges(const InterfaceData& interfaceData) const
+{
+    // The loop thread handles a call right after reading it, so calls only queue up for workers or executors
+    if (connection_.isDispatchingToWorkers())
+        return;
+
+    for (const auto& item : interfaceData.methods_)
+    {
+        const auto& methodData = item.second;
+        SDBUS_THROW_ERROR_IF( methodData.maxQueueAge_ != 0 && methodData.executor_ == nullptr
+                            , "Method call queue age requires a method executor or multi-threaded dispatch"
+                            , EINVAL );
+    }
+}
+
+bool Object::dropIfExpired(uint64_t receivedAt, uint64_t maxQueueAge)
+{
+    if (maxQueueAge == 0 || now() - receivedAt <= maxQueueAge)
+        return false;
+
+    expiredMethodCalls_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+std::shared_ptr<void> Object::trackMethodJob()
+{
+    std::lock_guard<std::mutex> lock(methodJobsMutex_);
+    ++methodJobsInFlight_;
+
+    return std::shared_ptr<void>(nullptr, [this](void*)
+    {
+        std::lock_guard<std::mutex> lock(methodJobsMutex_);
+        if (--methodJobsInFlight_ == 0)
+            methodJobsDone_.notify_all();
+    });
+}
+
+const std::vector<sd_bus_vtable>& Object::createInterfaceVTable(InterfaceData& interfaceData) const
 {
     auto& vtable = interfaceData.vtable_;
     assert(vtable.empty());
@@ -173,7 +339,7 @@ const std::vector<sd_bus_vtable>& Object::createInterfaceVTable(InterfaceData& i
     return vtable;
 }
 
-void Object::registerMethodsToVTable(const InterfaceData& interfaceData, std::vector<sd_bus_vtable>& vtable)
+void Object::registerMethodsToVTable(const InterfaceData& interfaceData, std::vector<sd_bus_vtable>& vtable) const
 {
     for (const auto& item : interfaceData.methods_)
     {
@@ -184,6 +350,7 @@ void Object::registerMethodsToVTable(const InterfaceData& interfaceData, std::ve
                                                , methodData.inputArgs_.c_str()
                                                , methodData.outputArgs_.c_str()
                                                , &Object::sdbus_method_callback
+                                               , vtableOffsetOf(&methodData)
                                                , methodData.flags_.toSdBusMethodFlags() ));
     }
 }
@@ -201,7 +368,7 @@ void Object::registerSignalsToVTable(const InterfaceData& interfaceData, std::ve
     }
 }
 
-void Object::registerPropertiesToVTable(const InterfaceData& interfaceData, std::vector<sd_bus_vtable>& vtable)
+void Object::registerPropertiesToVTable(const InterfaceData& interfaceData, std::vector<sd_bus_vtable>& vtable) const
 {
     for (const auto& item : interfaceData.properties_)
     {
@@ -212,16 +379,27 @@ void Object::registerPropertiesToVTable(const InterfaceData& interfaceData, std:
             vtable.push_back(createVTablePropertyItem( propertyName.c_str()
                                                      , propertyData.signature_.c_str()
                                                      , &Object::sdbus_property_get_callback
+                                                     , vtableOffsetOf(&propertyData)
                                                      , propertyData.flags_.toSdBusPropertyFlags() ));
         else
             vtable.push_back(createVTableWritablePropertyItem( propertyName.c_str()
                                                              , propertyData.signature_.c_str()
                                                              , &Object::sdbus_property_get_callback
                                                              , &Object::sdbus_property_set_callback
+                                                             , vtableOffsetOf(&propertyData)
                                                              , propertyData.flags_.toSdBusWritablePropertyFlags() ));
     }
 }
 
+std::size_t Object::vtableOffsetOf(const void* itemData) const
+{
+    // sd-bus passes vtable userdata (this object) plus the item's offset to the item's callbacks,
+    // so they get the data of their method or property right away, without looking it up by name.
+    // The data lives in map nodes that stay in place, wherever they are relative to the object;
+    // the offset wraps around in the unsigned arithmetic in that case and still adds up.
+    return reinterpret_cast<std::uintptr_t>(itemData) - reinterpret_cast<std::uintptr_t>(this);
+}
+
 void Object::activateInterfaceVTable( const std::string& interfaceName
                                     , InterfaceData& interfaceData
                                     , const std::vector<sd_bus_vtable>& vtable )
@@ -234,15 +412,58 @@ void Object::activateInterfaceVTable( const std::string& interfaceName
 
 int Object::sdbus_method_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
 {
-    auto* object = static_cast<Object*>(userData);
-    assert(object != nullptr);
+    auto* methodData = static_cast<InterfaceData::MethodData*>(userData);
+    assert(methodData != nullptr);
+    auto* object = methodData->object_;
 
     MethodCall message{sdbusMessage, &object->connection_.getSdBusInterface()};
 
-    // Note: The lookup can be optimized by using sorted vectors instead of associative containers
-    auto& callback = object->interfaces_[message.getInterfaceName()].methods_[message.getMemberName()].callback_;
+    auto& callback = methodData->callback_;
     assert(callback);
 
+    // Calls that waited too long are dropped without a reply; their callers have given up on them anyway
+    const auto maxQueueAge = methodData->maxQueueAge_;
+    const auto receivedAt = maxQueueAge != 0 ? receiveTimestampOf(sdbusMessage) : 0;
+    if (object->dropIfExpired(receivedAt, maxQueueAge))
+        return 1;
+
+    auto* executor = methodData->executor_;
+    if (executor != nullptr || object->connection_.isDispatchingToWorkers())
+    {
+        // The job counts as in flight until it is destroyed, whether it has run or not
+        auto job = [object, &callback, message, receivedAt, maxQueueAge, token = object->trackMethodJob()]() mutable
+        {
+            // The call may have expired while waiting in the worker queue
+            if (object->dropIfExpired(receivedAt, maxQueueAge))
+                return;
+
+            // Nothing may escape into the executor or worker thread
+            try
+            {
+                callback(message);
+            }
+            catch (const sdbus::Error& e)
+            {
+                sendErrorReply(message, e);
+            }
+            catch (const std::exception& e)
+            {
+                sendErrorReply(message, sdbus::Error("org.freedesktop.DBus.Error.Failed", e.what()));
+            }
+            catch (...)
+            {
+                sendErrorReply(message, sdbus::Error("org.freedesktop.DBus.Error.Failed", "Unknown error"));
+            }
+        };
+
+        if (executor != nullptr)
+            executor->execute(std::move(job));
+        else
+            object->connection_.dispatchToWorkers(message, std::move(job));
+
+        return 1;
+    }
+
     try
     {
         callback(message);
@@ -257,17 +478,17 @@ int Object::sdbus_method_callback(sd_bus_message *sdbusMessage, void *userData,
 
 int Object::sdbus_property_get_callback( sd_bus */*bus*/
                                        , const char */*objectPath*/
-                                       , const char *interface
-                                       , const char *property
+                                       , const char */*interface*/
+                                       , const char */*property*/
                                        , sd_bus_message *sdbusReply
                                        , void *userData
                                        , sd_bus_error *retError )
 {
-    auto* object = static_cast<Object*>(userData);
-    assert(object != nullptr);
+    auto* propertyData = static_cast<InterfaceData::PropertyData*>(userData);
+    assert(propertyData != nullptr);
+    auto* object = propertyData->object_;
 
-    // Note: The lookup can be optimized by using sorted vectors instead of associative containers
-    auto& callback = object->interfaces_[interface].properties_[property].getCallback_;
+    auto& callback = propertyData->getCallback_;
     // Getter can be empty - the case of "write-only" property
     if (!callback)
     {
@@ -291,17 +512,17 @@ int Object::sdbus_property_get_callback( sd_bus */*bus*/
 
 int Object::sdbus_property_set_callback( sd_bus */*bus*/
                                        , const char */*objectPath*/
-                                       , const char *interface
-                                       , const char *property
+                                       , const char */*interface*/
+                                       , const char */*property*/
                                        , sd_bus_message *sdbusValue
                                        , void *userData
                                        , sd_bus_error *retError )
 {
-    auto* object = static_cast<Object*>(userData);
-    assert(object != nullptr);
+    auto* propertyData = static_cast<InterfaceData::PropertyData*>(userData);
+    assert(propertyData != nullptr);
+    auto* object = propertyData->object_;
 
-    // Note: The lookup can be optimized by using sorted vectors instead of associative containers
-    auto& callback = object->interfaces_[interface].properties_[property].setCallback_;
+    auto& callback = propertyData->setCallback_;
     assert(callback);
 
     Message value{sdbusValue, &object->connection_.getSdBusInterface()};
@@ -34,6 +34,10 @@
 #include <vector>
 #include <functional>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
 #include <cassert>
 
 namespace sdbus {
@@ -44,6 +48,7 @@ namespace internal {
     {
     public:
         Object(sdbus::internal::IConnection& connection, std::string objectPath);
+        ~Object();
 
         void registerMethod( const std::string& interfaceName
                            , const std::string& methodName
@@ -79,24 +84,45 @@ namespace internal {
 
         void setInterfaceFlags(const std::string& interfaceName, Flags flags) override;
 
+        void setMaxMethodCallQueueAge(const std::string& interfaceName, uint64_t maxQueueAge) override;
+        void setMaxMethodCallQueueAge( const std::string& interfaceName
+                                     , const std::string& methodName
+                                     , uint64_t maxQueueAge ) override;
+        uint64_t getExpiredMethodCallCount() const override;
+
+        void setMethodExecutor(const std::string& interfaceName, IExecutor& executor) override;
+        void setMethodExecutor( const std::string& interfaceName
+                              , const std::string& methodName
+                              , IExecutor& executor ) override;
+
         void finishRegistration() override;
 
         sdbus::Signal createSignal(const std::string& interfaceName, const std::string& signalName) override;
         void emitSignal(const sdbus::Signal& message) override;
+        void cork() override;
+        void uncork() override;
 
     private:
         using InterfaceName = std::string;
         struct InterfaceData
         {
             using MethodName = std::string;
+            // Found by sd-bus through the offset of its vtable item, see vtableOffsetOf()
             struct MethodData
             {
+                Object* object_;
                 std::string inputArgs_;
                 std::string outputArgs_;
                 std::function<void(MethodCall&)> callback_;
                 Flags flags_;
+                uint64_t maxQueueAge_{}; // Resolved upon finishRegistration()
+                IExecutor* executor_{}; // Resolved upon finishRegistration()
             };
             std::map<MethodName, MethodData> methods_;
+            uint64_t maxQueueAge_{};
+            std::map<MethodName, uint64_t> methodMaxQueueAges_;
+            IExecutor* executor_{};
+            std::map<MethodName, IExecutor*> methodExecutors_;
             using SignalName = std::string;
             struct SignalData
             {
@@ -107,6 +133,7 @@ namespace internal {
             using PropertyName = std::string;
             struct PropertyData
             {
+                Object* object_;
                 std::string signature_;
                 property_get_callback getCallback_;
                 property_set_callback setCallback_;
@@ -119,10 +146,16 @@ namespace internal {
             std::unique_ptr<sd_bus_slot, std::function<void(sd_bus_slot*)>> slot_;
         };
 
-        static const std::vector<sd_bus_vtable>& createInterfaceVTable(InterfaceData& interfaceData);
-        static void registerMethodsToVTable(const InterfaceData& interfaceData, std::vector<sd_bus_vtable>& vtable);
+        static void resolveMaxQueueAges(InterfaceData& interfaceData);
+        static void resolveExecutors(InterfaceData& interfaceData);
+        void checkMaxQueueAges(const InterfaceData& interfaceData) const;
+        bool dropIfExpired(uint64_t receivedAt, uint64_t maxQueueAge);
+        std::shared_ptr<void> trackMethodJob();
+        const std::vector<sd_bus_vtable>& createInterfaceVTable(InterfaceData& interfaceData) const;
+        void registerMethodsToVTable(const InterfaceData& interfaceData, std::vector<sd_bus_vtable>& vtable) const;
         static void registerSignalsToVTable(const InterfaceData& interfaceData, std::vector<sd_bus_vtable>& vtable);
-        static void registerPropertiesToVTable(const InterfaceData& interfaceData, std::vector<sd_bus_vtable>& vtable);
+        void registerPropertiesToVTable(const InterfaceData& interfaceData, std::vector<sd_bus_vtable>& vtable) const;
+        std::size_t vtableOffsetOf(const void* itemData) const;
         void activateInterfaceVTable( const std::string& interfaceName
                                     , InterfaceData& interfaceData
                                     , const std::vector<sd_bus_vtable>& vtable );
@@ -147,6 +180,13 @@ namespace internal {
         sdbus::internal::IConnection& connection_;
         std::string objectPath_;
         std::map<InterfaceName, InterfaceData> interfaces_;
+        bool registrationFinished_{};
+        std::atomic<uint64_t> expiredMethodCalls_{};
+
+        // Method handlers handed over to executors or dispatch workers, still queued or running
+        std::size_t methodJobsInFlight_{};
+        std::mutex methodJobsMutex_;
+        std::condition_variable methodJobsDone_;
     };
 
 }
@@ -28,13 +28,54 @@
 #include <sdbus-c++/IConnection.h>
 #include <sdbus-c++/Error.h>
 #include "IConnection.h"
+#include "ConnectionPool.h"
+#include "ISdBus.h"
+#include "ScopeGuard.h"
 #include <systemd/sd-bus.h>
 #include <cassert>
 #include <chrono>
+#include <optional>
 #include <thread>
 
 namespace sdbus { namespace internal {
 
+namespace {
+
+std::shared_ptr<sdbus::internal::IConnection> acquireSharedConnection()
+{
+    // The connection lives as long as at least one proxy uses it. The first proxy
+    // opens it and starts its processing loop; when the last one is gone, it is closed.
+    static std::mutex mutex;
+    static std::weak_ptr<sdbus::internal::IConnection> sharedConnection;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto connection = sharedConnection.lock();
+    if (connection == nullptr)
+    {
+        auto newConnection = sdbus::createConnection();
+        auto* sdbusConnection = dynamic_cast<sdbus::internal::IConnection*>(newConnection.get());
+        assert(sdbusConnection != nullptr);
+        newConnection.release();
+
+        connection.reset(sdbusConnection, [](sdbus::internal::IConnection* connection)
+        {
+            // The last proxy may go away in a callback in the loop thread, which cannot join itself.
+            // Another thread then closes the connection, once the loop is through with the callback.
+            if (connection->isInProcessingLoopThread())
+                std::thread([connection](){ delete connection; }).detach();
+            else
+                delete connection;
+        });
+        connection->enterProcessingLoopAsync();
+        sharedConnection = connection;
+    }
+
+    return connection;
+}
+
+}
+
 ObjectProxy::ObjectProxy(sdbus::internal::IConnection& connection, std::string destination, std::string objectPath)
     : connection_(&connection, [](sdbus::internal::IConnection *){ /* Intentionally left empty */ })
     , destination_(std::move(destination))
@@ -56,9 +97,45 @@ ObjectProxy::ObjectProxy( std::unique_ptr<sdbus::internal::IConnection>&& connec
     connection_->enterProcessingLoopAsync();
 }
 
+ObjectProxy::ObjectProxy( std::shared_ptr<sdbus::internal::IConnection> connection
+                        , std::string destination
+                        , std::string objectPath )
+    : connection_(connection.get(), [connection](sdbus::internal::IConnection *){ /* Drops our share when the deleter goes away */ })
+    , destination_(std::move(destination))
+    , objectPath_(std::move(objectPath))
+{
+    // The connection is shared with other proxies and its processing loop is already running.
+}
+
+ObjectProxy::ObjectProxy( sdbus::internal::ConnectionPool& pool
+                        , std::string destination
+                        , std::string objectPath
+                        , IConnectionPool::CallDistribution distribution )
+    : connection_( &pool.getConnection(std::hash<std::string>{}(objectPath) % pool.getSize())
+                 , [](sdbus::internal::IConnection *){ /* Intentionally left empty */ } )
+    , destination_(std::move(destination))
+    , objectPath_(std::move(objectPath))
+    , pool_(&pool)
+    , distribution_(distribution)
+{
+    // The pool owns the connections and runs their processing loops.
+}
+
+ObjectProxy::~ObjectProxy()
+{
+    // Stop incoming signals first, then wait for the handlers of signals already handed over to
+    // dispatch workers, as they use the signal data of this proxy
+    for (auto& interfaceItem : interfaces_)
+        for (auto& signalItem : interfaceItem.second.signals_)
+            signalItem.second.slot_.reset();
+
+    std::unique_lock<std::mutex> lock(signalJobsMutex_);
+    signalJobsDone_.wait(lock, [this](){ return signalJobsInFlight_ == 0; });
+}
+
 MethodCall ObjectProxy::createMethodCall(const std::string& interfaceName, const std::string& methodName)
 {
-    return connection_->createMethodCall(destination_, objectPath_, interfaceName, methodName);
+    return selectConnectionForNextCall().createMethodCall(destination_, objectPath_, interfaceName, methodName);
 }
 
 AsyncMethodCall ObjectProxy::createAsyncMethodCall(const std::string& interfaceName, const std::string& methodName)
@@ -66,29 +143,169 @@ AsyncMethodCall ObjectProxy::createAsyncMethodCall(const std::string& interfaceN
     return AsyncMethodCall{ObjectProxy::createMethodCall(interfaceName, methodName)};
 }
 
-MethodReply ObjectProxy::callMethod(const MethodCall& message)
+MethodReply ObjectProxy::callMethod(const MethodCall& message, uint64_t timeout)
 {
-    return message.send();
+    timeout = resolveTimeout(timeout);
+
+    // A blocking sd_bus_call holds the bus for the whole round trip. If the connection's processing
+    // loop runs in another thread, we rather send the call asynchronously and wait for the loop
+    // to hand the reply over to us, so that more threads can have their calls in flight at once.
+    auto& connection = getConnectionOf(message);
+    if (message.doesntExpectReply() || connection.isInProcessingLoopThread())
+        return message.send(timeout);
+
+    return sendMethodCallMessageAndWaitForReply(connection, message, timeout);
 }
 
-void ObjectProxy::callMethod(const AsyncMethodCall& message, async_reply_handler asyncReplyCallback)
+PendingAsyncCall ObjectProxy::callMethod(const AsyncMethodCall& message, async_reply_handler asyncReplyCallback, uint64_t timeout)
 {
     auto callback = (void*)&ObjectProxy::sdbus_async_reply_handler;
-    // Allocated userData gets deleted in the sdbus_async_reply_handler
-    auto userData = new AsyncReplyUserData{*this, std::move(asyncReplyCallback)};
+    auto& connection = getConnectionOf(message);
+    auto callData = std::make_shared<AsyncCalls::CallData>(*this, connection, std::move(asyncReplyCallback));
+    auto* rawCallData = callData.get();
+    std::weak_ptr<void> weakData{callData};
+
+    // The call is tracked before it is sent, since its reply may arrive before send() returns.
+    // From then on, the tracking owns the call data, so the call data (and the slot) is always
+    // released by whoever untracks the call -- typically the reply handler in the event loop
+    // thread -- and never here, where we may be holding the lock of another bus.
+    pendingAsyncCalls_.addCall(std::move(callData));
+    try
+    {
+        message.send(callback, rawCallData, resolveTimeout(timeout), (void**)&rawCallData->slot);
+    }
+    catch (...)
+    {
+        pendingAsyncCalls_.removeCall(rawCallData);
+        throw;
+    }
+
+    // Let the processing loop take the new pending reply (and its timeout) into account
+    if (connection.isProcessingLoopRunning() && !connection.isInProcessingLoopThread())
+        connection.wakeUpProcessingLoop();
+
+    return PendingAsyncCall{std::move(weakData)};
+}
+
+sdbus::internal::IConnection& ObjectProxy::selectConnectionForNextCall()
+{
+    if (pool_ == nullptr || distribution_ == IConnectionPool::CallDistribution::ePerObject)
+        return *connection_;
+
+    auto index = nextConnection_.fetch_add(1, std::memory_order_relaxed) % pool_->getSize();
+    return pool_->getConnection(index);
+}
+
+sdbus::internal::IConnection& ObjectProxy::getConnectionOf(const Message& message)
+{
+    if (pool_ == nullptr)
+        return *connection_;
+
+    auto* connection = pool_->findConnectionOf(message);
+    SDBUS_THROW_ERROR_IF(connection == nullptr, "Method call message was not created by this proxy", EINVAL);
+    return *connection;
+}
+
+void ObjectProxy::setMethodCallTimeout(uint64_t timeout)
+{
+    methodCallTimeout_ = timeout;
+}
 
-    message.send(callback, userData);
+uint64_t ObjectProxy::resolveTimeout(uint64_t timeout) const
+{
+    // 0 passed down to sd-bus means the connection's method call timeout
+    return timeout != 0 ? timeout : methodCallTimeout_.load(std::memory_order_relaxed);
+}
+
+MethodReply ObjectProxy::sendMethodCallMessageAndWaitForReply( sdbus::internal::IConnection& connection
+                                                             , const MethodCall& message
+                                                             , uint64_t timeout )
+{
+    // Shared with the reply handler, which may still run after we have given up waiting
+    auto syncCallReplyData = std::make_shared<SyncCallReplyData>();
+
+    // Registered before the loop is checked, so that the loop exiting at any point after the check fails the call
+    auto loopExitHandler = connection.addLoopExitHandler([syncCallReplyData](){ syncCallReplyData->abortWaiting(); });
+    SCOPE_EXIT{ connection.removeLoopExitHandler(loopExitHandler); };
+
+    if (!connection.isProcessingLoopRunning())
+        return message.send(timeout);
+
+    auto pendingCall = callMethod(AsyncMethodCall{MethodCall{message}}, [syncCallReplyData](MethodReply& reply, const Error* error)
+    {
+        syncCallReplyData->sendMethodReplyToWaitingThread(reply, error);
+    }, timeout);
+
+    try
+    {
+        return syncCallReplyData->waitForMethodReply(timeout != 0 ? timeout : connection.getMethodCallTimeout());
+    }
+    catch (...)
+    {
+        pendingCall.cancel();
+        throw;
+    }
+}
+
+void ObjectProxy::SyncCallReplyData::sendMethodReplyToWaitingThread(MethodReply& reply, const Error* error)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    reply_ = reply;
+    if (error != nullptr)
+        error_ = std::make_unique<Error>(*error);
+    arrived_ = true;
+
+    lock.unlock();
+    cond_.notify_one();
+}
+
+void ObjectProxy::SyncCallReplyData::abortWaiting()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    aborted_ = true;
+
+    lock.unlock();
+    cond_.notify_one();
+}
+
+MethodReply ObjectProxy::SyncCallReplyData::waitForMethodReply(uint64_t timeout)
+{
+    auto hasArrivedOrAborted = [this](){ return arrived_ || aborted_; };
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Timeouts beyond the range of std::chrono::microseconds (e.g. UINT64_MAX) are as good as infinite
+    if (timeout > static_cast<uint64_t>(std::chrono::microseconds::max().count()))
+        cond_.wait(lock, hasArrivedOrAborted);
+    else if (!cond_.wait_for(lock, std::chrono::microseconds(timeout), hasArrivedOrAborted))
+        SDBUS_THROW_ERROR("Method call timed out", ETIMEDOUT);
+
+    if (!arrived_)
+        SDBUS_THROW_ERROR("Processing loop exited before the method reply arrived", ECANCELED);
+    if (error_ != nullptr)
+        throw *error_;
+
+    return std::move(reply_);
 }
 
 void ObjectProxy::registerSignalHandler( const std::string& interfaceName
                                        , const std::string& signalName
                                        , signal_handler signalHandler )
+{
+    registerSignalHandler(interfaceName, signalName, SignalFilter{}, std::move(signalHandler));
+}
+
+void ObjectProxy::registerSignalHandler( const std::string& interfaceName
+                                       , const std::string& signalName
+                                       , const SignalFilter& filter
+                                       , signal_handler signalHandler )
 {
     SDBUS_THROW_ERROR_IF(!signalHandler, "Invalid signal handler provided", EINVAL);
 
     auto& interface = interfaces_[interfaceName];
 
-    InterfaceData::SignalData signalData{std::move(signalHandler), nullptr};
+    InterfaceData::SignalData signalData{this, std::move(signalHandler), filter, nullptr};
     auto insertionResult = interface.signals_.emplace(signalName, std::move(signalData));
 
     auto inserted = insertionResult.second;
@@ -97,64 +314,262 @@ void ObjectProxy::registerSignalHandler( const std::string& interfaceName
 
 void ObjectProxy::finishRegistration()
 {
-    registerSignalHandlers(*connection_);
+    registrationFinished_ = true;
+
+    if (signalSubscription_ == SignalSubscription::eEager)
+        registerSignalHandlers(*connection_);
+}
+
+void ObjectProxy::setSignalSubscription(SignalSubscription subscription)
+{
+    SDBUS_THROW_ERROR_IF(registrationFinished_, "Cannot set signal subscription after registration has finished", EBUSY);
+
+    signalSubscription_ = subscription;
+}
+
+void ObjectProxy::enableSignalHandler(const std::string& interfaceName, const std::string& signalName)
+{
+    SDBUS_THROW_ERROR_IF(!registrationFinished_, "Cannot enable signal handler before registration has finished", EBUSY);
+
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto& signalData = findSignalData(interfaceName, signalName);
+    if (signalData.slot_ != nullptr)
+        return;
+
+    subscribeToSignal(*connection_, interfaceName, signalName, signalData);
+    waitForSignalSubscriptions(*connection_);
+}
+
+void ObjectProxy::disableSignalHandler(const std::string& interfaceName, const std::string& signalName)
+{
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto& signalData = findSignalData(interfaceName, signalName);
+
+    // Releasing the slot has sd-bus remove the match rule from the daemon
+    signalData.slot_.reset();
 }
 
 void ObjectProxy::registerSignalHandlers(sdbus::internal::IConnection& connection)
 {
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+
     for (auto& interfaceItem : interfaces_)
     {
         const auto& interfaceName = interfaceItem.first;
         auto& signalsOnInterface = interfaceItem.second.signals_;
 
         for (auto& signalItem : signalsOnInterface)
-        {
-            const auto& signalName = signalItem.first;
-            auto& slot = signalItem.second.slot_;
-            auto* rawSlotPtr = connection.registerSignalHandler( objectPath_
-                                                               , interfaceName
-                                                               , signalName
-                                                               , &ObjectProxy::sdbus_signal_callback
-                                                               , this );
-            slot.reset(rawSlotPtr);
-            slot.get_deleter() = [&connection](sd_bus_slot *slot){ connection.unregisterSignalHandler(slot); };
-        }
+            subscribeToSignal(connection, interfaceName, signalItem.first, signalItem.second);
     }
+
+    if (!interfaces_.empty())
+        waitForSignalSubscriptions(connection);
 }
 
-int ObjectProxy::sdbus_async_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError)
+void ObjectProxy::subscribeToSignal( sdbus::internal::IConnection& connection
+                                   , const std::string& interfaceName
+                                   , const std::string& signalName
+                                   , InterfaceData::SignalData& signalData )
 {
-    // We are assuming the ownership of the async reply handler pointer passed here
-    std::unique_ptr<AsyncReplyUserData> asyncReplyUserData{static_cast<AsyncReplyUserData*>(userData)};
-    assert(asyncReplyUserData != nullptr);
-    assert(asyncReplyUserData->callback);
-
-    MethodReply message{sdbusMessage, &asyncReplyUserData->proxy.connection_->getSdBusInterface()};
+    signalData.slot_ = connection.registerSignalHandler( objectPath_
+                                                       , interfaceName
+                                                       , signalName
+                                                       , signalData.filter_
+                                                       , &ObjectProxy::sdbus_signal_callback
+                                                       , &ObjectProxy::sdbus_signal_subscription_callback
+                                                       , &signalData );
+}
 
-    const auto* error = sd_bus_message_get_error(sdbusMessage);
-    if (error == nullptr)
+void ObjectProxy::waitForSignalSubscriptions(sdbus::internal::IConnection& connection)
+{
+    // Peer-to-peer connections install match rules locally, and within message dispatch the connection
+    // has installed them synchronously -- there is nobody to wait for
+    if (!connection.isConnectedToBusDaemon() || connection.isDispatchingInCallingThread())
+        return;
+
+    // The daemon handles our messages in order. Once it answers a trivial call, it has installed all
+    // the match rules sent before the call, too -- so it is one round trip for any number of them.
+    // (Peer.Ping would do as well, but bus security policies may deny it, unlike the bus interface.)
+    auto barrier = connection.createMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "GetId");
+    auto takeSubscriptionError = [this]()
     {
-        asyncReplyUserData->callback(message, nullptr);
+        std::lock_guard<std::mutex> lock(subscriptionErrorMutex_);
+        return std::move(subscriptionError_);
+    };
+    try
+    {
+        callMethod(barrier, 0);
+        connection.processMatchInstallReplies();
     }
-    else
+    catch (...)
     {
-        sdbus::Error exception(error->name, error->message);
-        asyncReplyUserData->callback(message, &exception);
+        // Refusals processed so far belong to this subscription, they must not be blamed on a later one
+        takeSubscriptionError();
+        throw;
     }
+
+    // Refusals arrive before the barrier reply, so they have been handled by now -- by the processing loop,
+    // or by processing the bus just above
+    if (auto error = takeSubscriptionError())
+        throw Error(std::move(*error));
+}
+
+std::shared_ptr<void> ObjectProxy::trackSignalJob()
+{
+    std::lock_guard<std::mutex> lock(signalJobsMutex_);
+    ++signalJobsInFlight_;
+
+    return std::shared_ptr<void>(nullptr, [this](void*)
+    {
+        std::lock_guard<std::mutex> lock(signalJobsMutex_);
+        if (--signalJobsInFlight_ == 0)
+            signalJobsDone_.notify_all();
+    });
+}
+
+ObjectProxy::InterfaceData::SignalData& ObjectProxy::findSignalData(const std::string& interfaceName, const std::string& signalName)
+{
+    auto interfaceIt = interfaces_.find(interfaceName);
+    SDBUS_THROW_ERROR_IF(interfaceIt == interfaces_.end(), "No signal handler registered on the interface", EINVAL);
+    auto signalIt = interfaceIt->second.signals_.find(signalName);
+    SDBUS_THROW_ERROR_IF(signalIt == interfaceIt->second.signals_.end(), "No handler registered for the signal", EINVAL);
+
+    return signalIt->second;
+}
+
+ObjectProxy::AsyncCalls::CallData::CallData( ObjectProxy& proxy
+                                            , sdbus::internal::IConnection& connection
+                                            , async_reply_handler callback )
+    : proxy(proxy)
+    , connection(connection)
+    , callback(std::move(callback))
+{
+}
+
+ObjectProxy::AsyncCalls::CallData::~CallData()
+{
+    // Releasing a slot of a call that is still pending cancels the call in sd-bus
+    if (slot != nullptr)
+        connection.getSdBusInterface().sd_bus_slot_unref(slot);
+}
+
+ObjectProxy::AsyncCalls::~AsyncCalls()
+{
+    clear();
+}
+
+void ObjectProxy::AsyncCalls::addCall(std::shared_ptr<CallData> callData)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto* key = callData.get();
+    calls_.emplace(key, std::move(callData));
+}
+
+std::shared_ptr<ObjectProxy::AsyncCalls::CallData> ObjectProxy::AsyncCalls::removeCall(const CallData* callData)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto it = calls_.find(callData);
+    if (it == calls_.end())
+        return nullptr;
+
+    auto removed = std::move(it->second);
+    calls_.erase(it);
+
+    // Returned to the caller so that the slot is released (which locks the bus) out of our lock
+    return removed;
+}
+
+bool ObjectProxy::AsyncCalls::containsCall(const CallData* callData)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return calls_.find(callData) != calls_.end();
+}
+
+void ObjectProxy::AsyncCalls::clear()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto calls = std::move(calls_);
+    calls_.clear();
+    lock.unlock();
+
+    // Releasing the slots here, out of the lock, cancels the calls in sd-bus
+    calls.clear();
+}
+
+int ObjectProxy::sdbus_async_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error */*retError*/)
+{
+    auto* callData = static_cast<AsyncCalls::CallData*>(userData);
+    assert(callData != nullptr);
+
+    // A call that is no longer tracked has just been cancelled and its reply is not wanted
+    auto asyncCallData = callData->proxy.pendingAsyncCalls_.removeCall(callData);
+    if (asyncCallData == nullptr)
+        return 1;
+    assert(asyncCallData->callback);
+
+    auto& sdbus = asyncCallData->connection.getSdBusInterface();
+    MethodReply message{sdbusMessage, &sdbus};
+
+    // The handler runs once this bus is unlocked. It may well use another connection, whose
+    // processing thread may at the same time be calling into this one (e.g. a coroutine method
+    // served there, awaiting a call made here), and holding both locks would deadlock them.
+    std::optional<sdbus::Error> exception;
+    if (const auto* error = sd_bus_message_get_error(sdbusMessage))
+        exception.emplace(error->name, error->message);
+
+    sdbus.sd_bus_defer_until_processed([asyncCallData = std::move(asyncCallData), message = std::move(message), exception = std::move(exception)]() mutable
+    {
+        asyncCallData->callback(message, exception ? &*exception : nullptr);
+    });
+
+    return 1;
 }
 
 int ObjectProxy::sdbus_signal_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error */*retError*/)
 {
-    auto* proxy = static_cast<ObjectProxy*>(userData);
-    assert(proxy != nullptr);
+    auto* signalData = static_cast<InterfaceData::SignalData*>(userData);
+    assert(signalData != nullptr);
+    auto* proxy = signalData->proxy_;
 
     Signal message{sdbusMessage, &proxy->connection_->getSdBusInterface()};
 
-    // Note: The lookup can be optimized by using sorted vectors instead of associative containers
-    auto& callback = proxy->interfaces_[message.getInterfaceName()].signals_[message.getMemberName()].callback_;
+    auto& callback = signalData->callback_;
     assert(callback);
 
-    callback(message);
+    // The job counts as in flight until it is destroyed, whether it has run or not
+    if (proxy->connection_->isDispatchingToWorkers())
+        proxy->connection_->dispatchToWorkers(message, [&callback, message, token = proxy->trackSignalJob()]() mutable
+        {
+            try
+            {
+                callback(message);
+            }
+            catch (...)
+            {
+                // A signal has no one to report a failure to (e.g. a malformed signal that fails
+                // to deserialize), and nothing may escape into the worker thread
+            }
+        });
+    else
+        callback(message);
+
+    return 1;
+}
+
+int ObjectProxy::sdbus_signal_subscription_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error */*retError*/)
+{
+    auto* signalData = static_cast<InterfaceData::SignalData*>(userData);
+    assert(signalData != nullptr);
+    auto* proxy = signalData->proxy_;
+
+    const auto* error = sd_bus_message_get_error(sdbusMessage);
+    if (error == nullptr)
+        return 1;
+
+    std::lock_guard<std::mutex> lock(proxy->subscriptionErrorMutex_);
+    if (proxy->subscriptionError_ == nullptr)
+        proxy->subscriptionError_ = std::make_unique<Error>(error->name, error->message);
 
     return 1;
 }
@@ -163,6 +578,31 @@ int ObjectProxy::sdbus_signal_callback(sd_bus_message *sdbusMessage, void *userD
 
 namespace sdbus {
 
+PendingAsyncCall::PendingAsyncCall(std::weak_ptr<void> callData)
+    : callData_(std::move(callData))
+{
+}
+
+void PendingAsyncCall::cancel()
+{
+    auto callData = callData_.lock();
+    if (callData == nullptr)
+        return;
+
+    auto* data = static_cast<internal::ObjectProxy::AsyncCalls::CallData*>(callData.get());
+    data->proxy.pendingAsyncCalls_.removeCall(data);
+}
+
+bool PendingAsyncCall::isPending() const
+{
+    auto callData = callData_.lock();
+    if (callData == nullptr)
+        return false;
+
+    auto* data = static_cast<internal::ObjectProxy::AsyncCalls::CallData*>(callData.get());
+    return data->proxy.pendingAsyncCalls_.containsCall(data);
+}
+
 std::unique_ptr<sdbus::IObjectProxy> createObjectProxy( IConnection& connection
                                                       , std::string destination
                                                       , std::string objectPath )
@@ -189,12 +629,24 @@ std::unique_ptr<sdbus::IObjectProxy> createObjectProxy( std::unique_ptr<IConnect
                                                          , std::move(objectPath) );
 }
 
+std::unique_ptr<sdbus::IObjectProxy> createObjectProxy( IConnectionPool& pool
+                                                      , std::string destination
+                                                      , std::string objectPath
+                                                      , IConnectionPool::CallDistribution distribution )
+{
+    auto* sdbusPool = dynamic_cast<sdbus::internal::ConnectionPool*>(&pool);
+    SDBUS_THROW_ERROR_IF(!sdbusPool, "Connection pool is not a real sdbus-c++ connection pool", EINVAL);
+
+    return std::make_unique<sdbus::internal::ObjectProxy>( *sdbusPool
+                                                         , std::move(destination)
+                                                         , std::move(objectPath)
+                                                         , distribution );
+}
+
 std::unique_ptr<sdbus::IObjectProxy> createObjectProxy( std::string destination
                                                       , std::string objectPath )
 {
-    auto connection = sdbus::createConnection();
-
-    auto sdbusConnection = std::unique_ptr<sdbus::internal::IConnection>(dynamic_cast<sdbus::internal::IConnection*>(connection.release()));
+    auto sdbusConnection = sdbus::internal::acquireSharedConnection();
     assert(sdbusConnection != nullptr);
 
     return std::make_unique<sdbus::internal::ObjectProxy>( std::move(sdbusConnection)
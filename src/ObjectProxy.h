@@ -27,14 +27,23 @@
 #define SDBUS_CXX_INTERNAL_OBJECTPROXY_H_
 
 #include <sdbus-c++/IObjectProxy.h>
+#include <sdbus-c++/IConnectionPool.h>
+#include <sdbus-c++/Message.h>
+#include <sdbus-c++/Error.h>
+#include "IConnection.h"
 #include <systemd/sd-bus.h>
 #include <string>
 #include <memory>
 #include <map>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
 
 // Forward declarations
 namespace sdbus { namespace internal {
     class IConnection;
+    class ConnectionPool;
 }}
 
 namespace sdbus {
@@ -50,47 +59,138 @@ namespace internal {
         ObjectProxy( std::unique_ptr<sdbus::internal::IConnection>&& connection
                    , std::string destination
                    , std::string objectPath );
+        ObjectProxy( std::shared_ptr<sdbus::internal::IConnection> connection
+                   , std::string destination
+                   , std::string objectPath );
+        ObjectProxy( sdbus::internal::ConnectionPool& pool
+                   , std::string destination
+                   , std::string objectPath
+                   , IConnectionPool::CallDistribution distribution );
+        ~ObjectProxy();
 
         MethodCall createMethodCall(const std::string& interfaceName, const std::string& methodName) override;
         AsyncMethodCall createAsyncMethodCall(const std::string& interfaceName, const std::string& methodName) override;
-        MethodReply callMethod(const MethodCall& message) override;
-        void callMethod(const AsyncMethodCall& message, async_reply_handler asyncReplyCallback) override;
+        MethodReply callMethod(const MethodCall& message, uint64_t timeout) override;
+        PendingAsyncCall callMethod(const AsyncMethodCall& message, async_reply_handler asyncReplyCallback, uint64_t timeout) override;
+        void setMethodCallTimeout(uint64_t timeout) override;
 
         void registerSignalHandler( const std::string& interfaceName
                                   , const std::string& signalName
                                   , signal_handler signalHandler ) override;
+        void registerSignalHandler( const std::string& interfaceName
+                                  , const std::string& signalName
+                                  , const SignalFilter& filter
+                                  , signal_handler signalHandler ) override;
         void finishRegistration() override;
+        void setSignalSubscription(SignalSubscription subscription) override;
+        void enableSignalHandler(const std::string& interfaceName, const std::string& signalName) override;
+        void disableSignalHandler(const std::string& interfaceName, const std::string& signalName) override;
 
     private:
-        struct AsyncReplyUserData
+        friend PendingAsyncCall;
+
+        class AsyncCalls
         {
-            ObjectProxy& proxy;
-            async_reply_handler callback;
+        public:
+            struct CallData
+            {
+                CallData(ObjectProxy& proxy, sdbus::internal::IConnection& connection, async_reply_handler callback);
+                ~CallData();
+
+                ObjectProxy& proxy;
+                sdbus::internal::IConnection& connection;
+                async_reply_handler callback;
+                sd_bus_slot* slot{};
+            };
+
+            ~AsyncCalls();
+            void addCall(std::shared_ptr<CallData> callData);
+            std::shared_ptr<CallData> removeCall(const CallData* callData);
+            bool containsCall(const CallData* callData);
+            void clear();
+
+        private:
+            std::mutex mutex_;
+            std::unordered_map<const CallData*, std::shared_ptr<CallData>> calls_;
         };
 
-        void registerSignalHandlers(sdbus::internal::IConnection& connection);
-        static int sdbus_async_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
-        static int sdbus_signal_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        class SyncCallReplyData
+        {
+        public:
+            void sendMethodReplyToWaitingThread(MethodReply& reply, const Error* error);
+            void abortWaiting();
+            MethodReply waitForMethodReply(uint64_t timeout);
 
-    private:
-        std::unique_ptr< sdbus::internal::IConnection
-                       , std::function<void(sdbus::internal::IConnection*)>
-                       > connection_;
-        std::string destination_;
-        std::string objectPath_;
+        private:
+            std::mutex mutex_;
+            std::condition_variable cond_;
+            bool arrived_{};
+            bool aborted_{};
+            MethodReply reply_;
+            std::unique_ptr<Error> error_;
+        };
 
         using InterfaceName = std::string;
         struct InterfaceData
         {
             using SignalName = std::string;
+            // Serves as userdata of the signal's match, so the callback finds it without a lookup
             struct SignalData
             {
+                ObjectProxy* proxy_;
                 signal_handler callback_;
-                std::unique_ptr<sd_bus_slot, std::function<void(sd_bus_slot*)>> slot_;
+                SignalFilter filter_;
+                SignalSlot slot_;
             };
             std::map<SignalName, SignalData> signals_;
         };
+
+        sdbus::internal::IConnection& selectConnectionForNextCall();
+        sdbus::internal::IConnection& getConnectionOf(const Message& message);
+        uint64_t resolveTimeout(uint64_t timeout) const;
+        MethodReply sendMethodCallMessageAndWaitForReply(sdbus::internal::IConnection& connection, const MethodCall& message, uint64_t timeout);
+        void registerSignalHandlers(sdbus::internal::IConnection& connection);
+        void subscribeToSignal( sdbus::internal::IConnection& connection
+                              , const std::string& interfaceName
+                              , const std::string& signalName
+                              , InterfaceData::SignalData& signalData );
+        void waitForSignalSubscriptions(sdbus::internal::IConnection& connection);
+        std::shared_ptr<void> trackSignalJob();
+        InterfaceData::SignalData& findSignalData(const std::string& interfaceName, const std::string& signalName);
+        static int sdbus_async_reply_handler(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_signal_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+        static int sdbus_signal_subscription_callback(sd_bus_message *sdbusMessage, void *userData, sd_bus_error *retError);
+
+    private:
+        std::unique_ptr< sdbus::internal::IConnection
+                       , std::function<void(sdbus::internal::IConnection*)>
+                       > connection_;
+        std::string destination_;
+        std::string objectPath_;
+
+        // Set only for proxies upon a connection pool. connection_ then refers to the
+        // pool connection that takes the signals, and per-object calls, of this proxy.
+        sdbus::internal::ConnectionPool* pool_{};
+        IConnectionPool::CallDistribution distribution_{IConnectionPool::CallDistribution::ePerObject};
+        std::atomic<std::size_t> nextConnection_{};
+
+        std::atomic<uint64_t> methodCallTimeout_{};
+
         std::map<InterfaceName, InterfaceData> interfaces_;
+
+        SignalSubscription signalSubscription_{SignalSubscription::eEager};
+        bool registrationFinished_{};
+        std::mutex subscriptionMutex_; // Serializes enabling and disabling of signal handlers
+        std::mutex subscriptionErrorMutex_;
+        std::unique_ptr<Error> subscriptionError_; // First match rule the daemon refused to install
+
+        // Signal handlers handed over to dispatch workers, still queued or running
+        std::size_t signalJobsInFlight_{};
+        std::mutex signalJobsMutex_;
+        std::condition_variable signalJobsDone_;
+
+        // Declared last so that pending calls are cancelled before anything else goes away
+        AsyncCalls pendingAsyncCalls_;
     };
 
 }}
@@ -0,0 +1,80 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file OutboundQueue.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OutboundQueue.h"
+#include <algorithm>
+#include <cassert>
+
+namespace sdbus { namespace internal {
+
+OutboundQueue::~OutboundQueue()
+{
+    assert(empty()); // The owner shall have drained the queue
+
+    auto* node = head_.load(std::memory_order_acquire);
+    while (node != nullptr)
+    {
+        auto* next = node->next_;
+        delete node;
+        node = next;
+    }
+}
+
+bool OutboundQueue::push(sd_bus_message* message)
+{
+    auto* node = new Node{message, nullptr};
+    auto* head = head_.load(std::memory_order_relaxed);
+    do
+    {
+        node->next_ = head;
+    } while (!head_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+    // The node may be consumed and deleted already here, so it must not be touched anymore
+    return head == nullptr;
+}
+
+void OutboundQueue::popAll(std::vector<sd_bus_message*>& messages)
+{
+    // Taking the whole stack at once rules out the ABA problem of popping single nodes
+    auto* node = head_.exchange(nullptr, std::memory_order_acquire);
+
+    auto first = messages.size();
+    while (node != nullptr)
+    {
+        messages.push_back(node->message_);
+        auto* next = node->next_;
+        delete node;
+        node = next;
+    }
+
+    std::reverse(messages.begin() + first, messages.end());
+}
+
+bool OutboundQueue::empty() const
+{
+    return head_.load(std::memory_order_relaxed) == nullptr;
+}
+
+}}
@@ -0,0 +1,65 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file OutboundQueue.h
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_OUTBOUNDQUEUE_H_
+#define SDBUS_CXX_INTERNAL_OUTBOUNDQUEUE_H_
+
+#include <systemd/sd-bus.h>
+#include <vector>
+#include <atomic>
+
+namespace sdbus { namespace internal {
+
+    // Lock-free multi-producer, single-consumer queue of messages waiting to be sent.
+    // Producers push onto an intrusive stack with a single CAS; the consumer takes
+    // the whole stack at once with an exchange and reverses it, which yields the messages
+    // in the order they were pushed. The queue does not manage message references.
+    class OutboundQueue
+    {
+    public:
+        OutboundQueue() = default;
+        OutboundQueue(const OutboundQueue&) = delete;
+        OutboundQueue& operator=(const OutboundQueue&) = delete;
+        ~OutboundQueue();
+
+        // Returns true if the queue was empty, i.e. if the consumer has to be woken up
+        bool push(sd_bus_message* message);
+        // Appends all queued messages to the given vector, oldest first
+        void popAll(std::vector<sd_bus_message*>& messages);
+        bool empty() const;
+
+    private:
+        struct Node
+        {
+            sd_bus_message* message_;
+            Node* next_;
+        };
+
+        std::atomic<Node*> head_{};
+    };
+
+}}
+
+#endif /* SDBUS_CXX_INTERNAL_OUTBOUNDQUEUE_H_ */
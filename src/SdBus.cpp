@@ -25,68 +25,107 @@
  */
 
 #include "SdBus.h"
+#include "ScopeGuard.h"
+#include <systemd/sd-id128.h>
+#include <unistd.h>
+#include <chrono>
+#include <utility>
 
 namespace sdbus { namespace internal {
 
 sd_bus_message* SdBus::sd_bus_message_ref(sd_bus_message *m)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_message_ref(m);
 }
 
 sd_bus_message* SdBus::sd_bus_message_unref(sd_bus_message *m)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_message_unref(m);
 }
 
 int SdBus::sd_bus_send(sd_bus *bus, sd_bus_message *m, uint64_t *cookie)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    if (bus == nullptr && cookie == nullptr)
+    {
+        auto hook = sendHook_.load(std::memory_order_acquire);
+        if (hook != nullptr)
+        {
+            auto r = hook(m, sendHookUserData_);
+            if (r != 0)
+                return r;
+        }
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_send(bus, m, cookie);
 }
 
+void SdBus::sd_bus_set_send_hook(sd_bus_send_hook_t hook, void *userdata)
+{
+    sendHookUserData_ = userdata;
+    sendHook_.store(hook, std::memory_order_release);
+}
+
+int SdBus::sd_bus_send_batch(sd_bus *bus, sd_bus_message **messages, size_t count)
+{
+    // One lock acquisition for the whole batch
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
+
+    int firstError = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto r = ::sd_bus_send(bus, messages[i], nullptr);
+        if (r < 0 && firstError == 0)
+            firstError = r;
+        ::sd_bus_message_unref(messages[i]);
+    }
+
+    return firstError;
+}
+
 int SdBus::sd_bus_call(sd_bus *bus, sd_bus_message *m, uint64_t usec, sd_bus_error *ret_error, sd_bus_message **reply)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_call(bus, m, usec, ret_error, reply);
 }
 
 int SdBus::sd_bus_call_async(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_call_async(bus, slot, m, callback, userdata, usec);
 }
 
 int SdBus::sd_bus_message_new_method_call(sd_bus *bus, sd_bus_message **m, const char *destination, const char *path, const char *interface, const char *member)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_message_new_method_call(bus, m, destination, path, interface, member);
 }
 
 int SdBus::sd_bus_message_new_signal(sd_bus *bus, sd_bus_message **m, const char *path, const char *interface, const char *member)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_message_new_signal(bus, m, path, interface, member);
 }
 
 int SdBus::sd_bus_message_new_method_return(sd_bus_message *call, sd_bus_message **m)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_message_new_method_return(call, m);
 }
 
 int SdBus::sd_bus_message_new_method_error(sd_bus_message *call, sd_bus_message **m, const sd_bus_error *e)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_message_new_method_error(call, m, e);
 }
@@ -101,51 +140,179 @@ int SdBus::sd_bus_open_system(sd_bus **ret)
     return ::sd_bus_open_system(ret);
 }
 
+int SdBus::sd_bus_open_direct(sd_bus **ret, const char *address)
+{
+    sd_bus* bus{};
+    auto r = ::sd_bus_new(&bus);
+    if (r < 0)
+        return r;
+    SCOPE_EXIT{ ::sd_bus_unref(bus); };
+
+    r = ::sd_bus_set_address(bus, address);
+    if (r < 0)
+        return r;
+
+    r = ::sd_bus_start(bus);
+    if (r < 0)
+        return r;
+
+    *ret = std::exchange(bus, nullptr);
+    return 0;
+}
+
+int SdBus::sd_bus_open_direct(sd_bus **ret, int fd)
+{
+    // Until the bus takes the socket over, closing it on failure is up to us
+    SCOPE_EXIT_NAMED(closeFdOnFailure){ ::close(fd); };
+
+    sd_bus* bus{};
+    auto r = ::sd_bus_new(&bus);
+    if (r < 0)
+        return r;
+    SCOPE_EXIT{ ::sd_bus_unref(bus); };
+
+    r = ::sd_bus_set_fd(bus, fd, fd);
+    if (r < 0)
+        return r;
+    closeFdOnFailure.dismiss();
+
+    r = ::sd_bus_start(bus);
+    if (r < 0)
+        return r;
+
+    *ret = std::exchange(bus, nullptr);
+    return 0;
+}
+
+int SdBus::sd_bus_open_server(sd_bus **ret, int fd)
+{
+    // Until the bus takes the socket over, closing it on failure is up to us
+    SCOPE_EXIT_NAMED(closeFdOnFailure){ ::close(fd); };
+
+    sd_bus* bus{};
+    auto r = ::sd_bus_new(&bus);
+    if (r < 0)
+        return r;
+    SCOPE_EXIT{ ::sd_bus_unref(bus); };
+
+    r = ::sd_bus_set_fd(bus, fd, fd);
+    if (r < 0)
+        return r;
+    closeFdOnFailure.dismiss();
+
+    sd_id128_t id;
+    r = ::sd_id128_randomize(&id);
+    if (r < 0)
+        return r;
+
+    r = ::sd_bus_set_server(bus, true, id);
+    if (r < 0)
+        return r;
+
+    r = ::sd_bus_start(bus);
+    if (r < 0)
+        return r;
+
+    *ret = std::exchange(bus, nullptr);
+    return 0;
+}
+
 int SdBus::sd_bus_request_name(sd_bus *bus, const char *name, uint64_t flags)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_request_name(bus, name, flags);
 }
 
+int SdBus::sd_bus_request_name_async(sd_bus *bus, sd_bus_slot **slot, const char *name, uint64_t flags, sd_bus_message_handler_t callback, void *userdata)
+{
+#if LIBSYSTEMD_VERSION >= 237
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
+
+    return ::sd_bus_request_name_async(bus, slot, name, flags, callback, userdata);
+#else
+    (void)bus;
+    (void)slot;
+    (void)name;
+    (void)flags;
+    (void)callback;
+    (void)userdata;
+    return -EOPNOTSUPP;
+#endif
+}
+
 int SdBus::sd_bus_release_name(sd_bus *bus, const char *name)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_release_name(bus, name);
 }
 
 int SdBus::sd_bus_add_object_vtable(sd_bus *bus, sd_bus_slot **slot, const char *path, const char *interface, const sd_bus_vtable *vtable, void *userdata)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_add_object_vtable(bus, slot, path, interface,  vtable, userdata);
 }
 
 int SdBus::sd_bus_add_match(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, void *userdata)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return :: sd_bus_add_match(bus, slot, match, callback, userdata);
 }
 
+int SdBus::sd_bus_add_match_async(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata)
+{
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
+
+#if LIBSYSTEMD_VERSION >= 237
+    return ::sd_bus_add_match_async(bus, slot, match, callback, install_callback, userdata);
+#else
+    (void)install_callback; // The synchronous variant either installs the match or fails right away
+    return ::sd_bus_add_match(bus, slot, match, callback, userdata);
+#endif
+}
+
 sd_bus_slot* SdBus::sd_bus_slot_unref(sd_bus_slot *slot)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     return ::sd_bus_slot_unref(slot);
 }
 
 int SdBus::sd_bus_process(sd_bus *bus, sd_bus_message **r)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::vector<std::function<void()>> deferredTasks;
+    int result;
+    {
+        std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
+
+        result = ::sd_bus_process(bus, r);
+        deferredTasks.swap(deferredTasks_);
+    }
+
+    for (auto& task : deferredTasks)
+        task();
+
+    return result;
+}
 
-    return ::sd_bus_process(bus, r);
+void SdBus::sd_bus_defer_until_processed(std::function<void()> task)
+{
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
+
+    deferredTasks_.push_back(std::move(task));
+}
+
+int SdBus::sd_bus_wait(sd_bus *bus, uint64_t timeout_usec)
+{
+    return ::sd_bus_wait(bus, timeout_usec);
 }
 
 int SdBus::sd_bus_get_poll_data(sd_bus *bus, PollData* data)
 {
-    std::unique_lock<std::recursive_mutex> lock(sdbusMutex_);
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
 
     auto r = ::sd_bus_get_fd(bus);
     if (r < 0)
@@ -162,8 +329,97 @@ int SdBus::sd_bus_get_poll_data(sd_bus *bus, PollData* data)
     return r;
 }
 
+sd_bus_message* SdBus::sd_bus_get_current_message(sd_bus *bus)
+{
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
+
+    return ::sd_bus_get_current_message(bus);
+}
+
+int SdBus::sd_bus_process_batch(sd_bus *bus, size_t max_messages, uint64_t max_usec, size_t *processed, PollData* data)
+{
+    // Processes up to max_messages messages, or until max_usec elapses. The lock is taken per message,
+    // so that other threads get to send in between, as the batch may well run for a while.
+    // Returns 1 if the budget got exhausted before the bus ran out of pending messages, 0 if there
+    // is nothing more to process. Either way, data is filled with the poll data for the next wait;
+    // after an exhausted budget, it times out right away, so that the wait only picks up what
+    // is ready by now (e.g. an exit request for the processing loop) and does not block.
+    using namespace std::chrono;
+    auto deadline = max_usec > 0 ? steady_clock::now() + microseconds(max_usec) : steady_clock::time_point::max();
+
+    bool exhausted{};
+    *processed = 0;
+    while (true)
+    {
+        if ((max_messages > 0 && *processed >= max_messages) || (max_usec > 0 && steady_clock::now() >= deadline))
+        {
+            exhausted = true;
+            break;
+        }
+
+        auto r = sd_bus_process(bus, nullptr);
+        if (r < 0)
+            return r;
+        if (r == 0)
+            break;
+
+        ++*processed;
+    }
+
+    auto r = sd_bus_get_poll_data(bus, data);
+    if (r < 0)
+        return r;
+
+    if (!exhausted)
+        return 0;
+
+    data->timeout_usec = 0;
+    return 1;
+}
+
+int SdBus::sd_bus_set_method_call_timeout(sd_bus *bus, uint64_t usec)
+{
+#if LIBSYSTEMD_VERSION >= 240
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
+
+    return ::sd_bus_set_method_call_timeout(bus, usec);
+#else
+    (void)bus;
+    (void)usec;
+    return -ENOTSUP;
+#endif
+}
+
+int SdBus::sd_bus_get_method_call_timeout(sd_bus *bus, uint64_t *ret)
+{
+#if LIBSYSTEMD_VERSION >= 240
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
+
+    return ::sd_bus_get_method_call_timeout(bus, ret);
+#else
+    (void)bus;
+    *ret = 25000000; // Built-in sd-bus default of 25 seconds
+    return 0;
+#endif
+}
+
+int SdBus::sd_bus_get_n_queued_write(sd_bus *bus, uint64_t *ret)
+{
+#if LIBSYSTEMD_VERSION >= 238
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
+
+    return ::sd_bus_get_n_queued_write(bus, ret);
+#else
+    (void)bus;
+    (void)ret;
+    return -EOPNOTSUPP;
+#endif
+}
+
 int SdBus::sd_bus_flush(sd_bus *bus)
 {
+    std::lock_guard<std::recursive_mutex> lock(sdbusMutex_);
+
     return ::sd_bus_flush(bus);
 }
 
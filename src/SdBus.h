@@ -29,6 +29,8 @@
 
 #include "ISdBus.h"
 #include <mutex>
+#include <atomic>
+#include <vector>
 
 namespace sdbus { namespace internal {
 
@@ -39,6 +41,8 @@ public:
     virtual sd_bus_message* sd_bus_message_unref(sd_bus_message *m) override;
 
     virtual int sd_bus_send(sd_bus *bus, sd_bus_message *m, uint64_t *cookie) override;
+    virtual void sd_bus_set_send_hook(sd_bus_send_hook_t hook, void *userdata) override;
+    virtual int sd_bus_send_batch(sd_bus *bus, sd_bus_message **messages, size_t count) override;
     virtual int sd_bus_call(sd_bus *bus, sd_bus_message *m, uint64_t usec, sd_bus_error *ret_error, sd_bus_message **reply) override;
     virtual int sd_bus_call_async(sd_bus *bus, sd_bus_slot **slot, sd_bus_message *m, sd_bus_message_handler_t callback, void *userdata, uint64_t usec) override;
 
@@ -49,20 +53,45 @@ public:
 
     virtual int sd_bus_open_user(sd_bus **ret) override;
     virtual int sd_bus_open_system(sd_bus **ret) override;
+    virtual int sd_bus_open_direct(sd_bus **ret, const char *address) override;
+    virtual int sd_bus_open_direct(sd_bus **ret, int fd) override;
+    virtual int sd_bus_open_server(sd_bus **ret, int fd) override;
     virtual int sd_bus_request_name(sd_bus *bus, const char *name, uint64_t flags) override;
+    virtual int sd_bus_request_name_async(sd_bus *bus, sd_bus_slot **slot, const char *name, uint64_t flags, sd_bus_message_handler_t callback, void *userdata) override;
     virtual int sd_bus_release_name(sd_bus *bus, const char *name) override;
     virtual int sd_bus_add_object_vtable(sd_bus *bus, sd_bus_slot **slot, const char *path, const char *interface, const sd_bus_vtable *vtable, void *userdata) override;
     virtual int sd_bus_add_match(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, void *userdata) override;
+    virtual int sd_bus_add_match_async(sd_bus *bus, sd_bus_slot **slot, const char *match, sd_bus_message_handler_t callback, sd_bus_message_handler_t install_callback, void *userdata) override;
     virtual sd_bus_slot* sd_bus_slot_unref(sd_bus_slot *slot) override;
 
     virtual int sd_bus_process(sd_bus *bus, sd_bus_message **r) override;
+    virtual void sd_bus_defer_until_processed(std::function<void()> task) override;
+    virtual int sd_bus_wait(sd_bus *bus, uint64_t timeout_usec) override;
     virtual int sd_bus_get_poll_data(sd_bus *bus, PollData* data) override;
+    virtual sd_bus_message* sd_bus_get_current_message(sd_bus *bus) override;
+    virtual int sd_bus_process_batch(sd_bus *bus, size_t max_messages, uint64_t max_usec, size_t *processed, PollData* data) override;
+
+    virtual int sd_bus_set_method_call_timeout(sd_bus *bus, uint64_t usec) override;
+    virtual int sd_bus_get_method_call_timeout(sd_bus *bus, uint64_t *ret) override;
+
+    virtual int sd_bus_get_n_queued_write(sd_bus *bus, uint64_t *ret) override;
 
     virtual int sd_bus_flush(sd_bus *bus) override;
     virtual sd_bus *sd_bus_flush_close_unref(sd_bus *bus) override;
 
 private:
+    // Guards the sd_bus instance this object belongs to. sd-bus is not thread-safe, and even
+    // message reference counting and message creation modify the bus reference count, so all
+    // such operations must be serialized. Callers are expected to keep these calls rare (e.g.
+    // Message shares one sd-bus reference among all its copies) and to keep critical sections short.
     std::recursive_mutex sdbusMutex_;
+
+    // Filled by callbacks of sd_bus_process(), guarded by sdbusMutex_
+    std::vector<std::function<void()>> deferredTasks_;
+
+    // Consulted without the lock, the very point of the hook being to let senders avoid it
+    std::atomic<sd_bus_send_hook_t> sendHook_{};
+    void* sendHookUserData_{};
 };
 
 }}
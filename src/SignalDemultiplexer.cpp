@@ -0,0 +1,129 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file SignalDemultiplexer.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SignalDemultiplexer.h"
+#include <sdbus-c++/Error.h>
+#include <vector>
+#include <cassert>
+
+namespace sdbus { namespace internal {
+
+SignalDemultiplexer::Route* SignalDemultiplexer::addRoute( std::string objectPath
+                                                         , std::string interfaceName
+                                                         , std::string signalName
+                                                         , sd_bus_message_handler_t callback
+                                                         , void* userData )
+{
+    SDBUS_THROW_ERROR_IF(callback == nullptr, "Invalid signal handler provided", EINVAL);
+
+    auto route = std::make_unique<Route>(Route{std::move(objectPath), std::move(interfaceName), std::move(signalName), callback, userData});
+    auto* rawRoute = route.get();
+    Key key{rawRoute->objectPath_, rawRoute->interfaceName_, rawRoute->signalName_};
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    routes_.emplace(key, std::move(route));
+
+    return rawRoute;
+}
+
+void SignalDemultiplexer::removeRoute(Route* route)
+{
+    assert(route != nullptr);
+    Key key{route->objectPath_, route->interfaceName_, route->signalName_};
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto range = routes_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second.get() == route)
+        {
+            routes_.erase(it);
+            return;
+        }
+    }
+
+    assert(false && "Removing unknown signal route");
+}
+
+std::size_t SignalDemultiplexer::dispatch( std::string_view objectPath
+                                         , std::string_view interfaceName
+                                         , std::string_view signalName
+                                         , sd_bus_message* message
+                                         , sd_bus_error* retError )
+{
+    Key key{objectPath, interfaceName, signalName};
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto range = routes_.equal_range(key);
+    if (range.first == range.second)
+        return 0;
+
+    // The usual case: one proxy for the object, nothing to guard
+    if (std::next(range.first) == range.second)
+    {
+        const auto& route = *range.first->second;
+        route.callback_(message, route.userData_, retError);
+        return 1;
+    }
+
+    // A handler may remove other routes of the same signal, so they are looked up again before each call
+    std::vector<const Route*> routes;
+    for (auto it = range.first; it != range.second; ++it)
+        routes.push_back(it->second.get());
+
+    std::size_t dispatched{};
+    for (const auto* route : routes)
+    {
+        if (!containsRoute(key, route))
+            continue;
+        route->callback_(message, route->userData_, retError);
+        ++dispatched;
+    }
+
+    return dispatched;
+}
+
+bool SignalDemultiplexer::containsRoute(const Key& key, const Route* route) const
+{
+    auto range = routes_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it)
+        if (it->second.get() == route)
+            return true;
+
+    return false;
+}
+
+std::size_t SignalDemultiplexer::KeyHash::operator()(const Key& key) const
+{
+    std::hash<std::string_view> hash;
+
+    auto seed = hash(key.interfaceName_);
+    seed ^= hash(key.signalName_) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= hash(key.objectPath_) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+    return seed;
+}
+
+}}
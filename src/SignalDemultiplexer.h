@@ -0,0 +1,96 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file SignalDemultiplexer.h
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_SIGNALDEMULTIPLEXER_H_
+#define SDBUS_CXX_INTERNAL_SIGNALDEMULTIPLEXER_H_
+
+#include <systemd/sd-bus.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+
+namespace sdbus { namespace internal {
+
+    // Routes signals received through a shared match rule to the handlers registered
+    // for their exact object path, interface and member. The lookup hashes the names as
+    // given by the message, without building strings out of them. Handlers run under
+    // the routing lock, so once removeRoute() returns, the route's handler no longer runs
+    // (unless removeRoute() is called from that very handler).
+    class SignalDemultiplexer
+    {
+    public:
+        struct Route
+        {
+            std::string objectPath_;
+            std::string interfaceName_;
+            std::string signalName_;
+            sd_bus_message_handler_t callback_;
+            void* userData_;
+        };
+
+        Route* addRoute( std::string objectPath
+                       , std::string interfaceName
+                       , std::string signalName
+                       , sd_bus_message_handler_t callback
+                       , void* userData );
+        void removeRoute(Route* route);
+
+        // Returns the number of handlers the signal has been routed to
+        std::size_t dispatch( std::string_view objectPath
+                            , std::string_view interfaceName
+                            , std::string_view signalName
+                            , sd_bus_message* message
+                            , sd_bus_error* retError );
+
+    private:
+        struct Key
+        {
+            std::string_view objectPath_;
+            std::string_view interfaceName_;
+            std::string_view signalName_;
+
+            bool operator==(const Key& other) const
+            {
+                return objectPath_ == other.objectPath_ && interfaceName_ == other.interfaceName_ && signalName_ == other.signalName_;
+            }
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        bool containsRoute(const Key& key, const Route* route) const;
+
+        // Keys view the strings of their routes, which do not move while the routes are in the table
+        std::recursive_mutex mutex_;
+        std::unordered_multimap<Key, std::unique_ptr<Route>, KeyHash> routes_;
+    };
+
+}}
+
+#endif /* SDBUS_CXX_INTERNAL_SIGNALDEMULTIPLEXER_H_ */
@@ -0,0 +1,180 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file ThreadPool.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadPool.h"
+#include <sdbus-c++/Error.h>
+#include <algorithm>
+#include <cassert>
+
+namespace sdbus { namespace internal {
+
+namespace {
+    // Pool and worker the current thread belongs to, if any
+    thread_local const ThreadPool* currentPool{};
+    thread_local std::size_t currentWorkerIndex{};
+}
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    SDBUS_THROW_ERROR_IF(threadCount == 0, "Invalid number of thread pool threads", EINVAL);
+
+    workers_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+        workers_.push_back(std::make_unique<Worker>());
+
+    // Workers steal from each other, so all of them must exist before the first one starts
+    for (std::size_t i = 0; i < threadCount; ++i)
+        workers_[i]->thread_ = std::thread([this, i](){ run(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    // Workers finish all tasks already submitted before they exit
+    std::unique_lock<std::mutex> lock(idleMutex_);
+    exit_ = true;
+    lock.unlock();
+    idleCond_.notify_all();
+
+    for (auto& worker : workers_)
+        worker->thread_.join();
+}
+
+void ThreadPool::execute(std::function<void()> task)
+{
+    assert(task);
+
+    auto* worker = currentWorker();
+    const bool spawned = worker != nullptr;
+    if (!spawned)
+        worker = workers_[nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size()].get();
+
+    // Counted before it is queued, so the count never drops below the number of queued tasks.
+    // Pairs with the idle worker registering itself before re-checking the queued task
+    // count in waitForTasks(), so either we see the idle worker or it sees our task.
+    queuedTasks_.fetch_add(1);
+
+    std::unique_lock<std::mutex> lock(worker->mutex_);
+    (spawned ? worker->spawnedTasks_ : worker->submittedTasks_).push_back(std::move(task));
+    lock.unlock();
+
+    if (idleWorkers_.load() != 0)
+    {
+        std::lock_guard<std::mutex> idleLock(idleMutex_);
+        idleCond_.notify_one();
+    }
+}
+
+std::size_t ThreadPool::getThreadCount() const
+{
+    return workers_.size();
+}
+
+ThreadPool::Worker* ThreadPool::currentWorker()
+{
+    return currentPool == this ? workers_[currentWorkerIndex].get() : nullptr;
+}
+
+void ThreadPool::run(std::size_t index)
+{
+    currentPool = this;
+    currentWorkerIndex = index;
+
+    std::function<void()> task;
+    while (true)
+    {
+        if (popTask(index, task))
+        {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                // Tasks are not supposed to throw (see IExecutor::execute()), but if one does, the pool thread lives on
+            }
+            task = nullptr;
+            continue;
+        }
+
+        if (!waitForTasks())
+            break; // Exit requested and nothing more to do
+    }
+}
+
+bool ThreadPool::popTask(std::size_t index, std::function<void()>& task)
+{
+    auto take = [this, &task](std::deque<std::function<void()>>& tasks, bool newest)
+    {
+        if (tasks.empty())
+            return false;
+
+        task = std::move(newest ? tasks.back() : tasks.front());
+        newest ? tasks.pop_back() : tasks.pop_front();
+        queuedTasks_.fetch_sub(1);
+        return true;
+    };
+
+    {
+        auto& own = *workers_[index];
+        std::lock_guard<std::mutex> lock(own.mutex_);
+        if (take(own.spawnedTasks_, true) || take(own.submittedTasks_, false))
+            return true;
+    }
+
+    for (std::size_t i = 1; i < workers_.size(); ++i)
+    {
+        auto& victim = *workers_[(index + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex_);
+        if (take(victim.submittedTasks_, false) || take(victim.spawnedTasks_, false))
+            return true;
+    }
+
+    return false;
+}
+
+bool ThreadPool::waitForTasks()
+{
+    std::unique_lock<std::mutex> lock(idleMutex_);
+
+    idleWorkers_.fetch_add(1);
+    idleCond_.wait(lock, [this](){ return queuedTasks_.load() != 0 || exit_; });
+    idleWorkers_.fetch_sub(1);
+
+    return queuedTasks_.load() != 0;
+}
+
+}}
+
+namespace sdbus {
+
+std::unique_ptr<sdbus::IExecutor> createThreadPool(std::size_t threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    return std::make_unique<sdbus::internal::ThreadPool>(threadCount);
+}
+
+}
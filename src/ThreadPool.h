@@ -0,0 +1,84 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file ThreadPool.h
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_THREADPOOL_H_
+#define SDBUS_CXX_INTERNAL_THREADPOOL_H_
+
+#include <sdbus-c++/IExecutor.h>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+
+namespace sdbus { namespace internal {
+
+    // Work-stealing thread pool. Each worker owns two task queues: tasks submitted from
+    // outside the pool, run in the order of submission, and tasks spawned by the worker's
+    // own tasks, run most recent first (which is cache friendly for tasks spawning tasks)
+    // and before the submitted ones. Workers steal the oldest tasks of other workers.
+    // Idle workers sleep on a shared condition variable, which submitters only touch
+    // when some worker is actually idle.
+    class ThreadPool
+        : public sdbus::IExecutor
+    {
+    public:
+        explicit ThreadPool(std::size_t threadCount);
+        ~ThreadPool() override;
+
+        void execute(std::function<void()> task) override;
+        std::size_t getThreadCount() const;
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex_;
+            std::deque<std::function<void()>> submittedTasks_;
+            std::deque<std::function<void()>> spawnedTasks_;
+            std::thread thread_;
+        };
+
+        void run(std::size_t index);
+        bool popTask(std::size_t index, std::function<void()>& task);
+        bool waitForTasks();
+        Worker* currentWorker();
+
+    private:
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::atomic<std::size_t> nextWorker_{};
+        std::atomic<std::size_t> queuedTasks_{};
+        std::atomic<std::size_t> idleWorkers_{};
+        std::mutex idleMutex_;
+        std::condition_variable idleCond_;
+        bool exit_{};
+    };
+
+}}
+
+#endif /* SDBUS_CXX_INTERNAL_THREADPOOL_H_ */
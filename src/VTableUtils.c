@@ -36,9 +36,10 @@ sd_bus_vtable createVTableMethodItem( const char *member
                                     , const char *signature
                                     , const char *result
                                     , sd_bus_message_handler_t handler
+                                    , size_t offset
                                     , uint64_t flags )
 {
-    struct sd_bus_vtable vtableItem = SD_BUS_METHOD(member, signature, result, handler, flags);
+    struct sd_bus_vtable vtableItem = SD_BUS_METHOD_WITH_OFFSET(member, signature, result, handler, offset, flags);
     return vtableItem;
 }
 
@@ -53,9 +54,10 @@ sd_bus_vtable createVTableSignalItem( const char *member
 sd_bus_vtable createVTablePropertyItem( const char *member
                                       , const char *signature
                                       , sd_bus_property_get_t getter
+                                      , size_t offset
                                       , uint64_t flags )
 {
-    struct sd_bus_vtable vtableItem = SD_BUS_PROPERTY(member, signature, getter, 0, flags);
+    struct sd_bus_vtable vtableItem = SD_BUS_PROPERTY(member, signature, getter, offset, flags);
     return vtableItem;
 }
 
@@ -63,9 +65,10 @@ sd_bus_vtable createVTableWritablePropertyItem( const char *member
                                               , const char *signature
                                               , sd_bus_property_get_t getter
                                               , sd_bus_property_set_t setter
+                                              , size_t offset
                                               , uint64_t flags )
 {
-    struct sd_bus_vtable vtableItem = SD_BUS_WRITABLE_PROPERTY(member, signature, getter, setter, 0, flags);
+    struct sd_bus_vtable vtableItem = SD_BUS_WRITABLE_PROPERTY(member, signature, getter, setter, offset, flags);
     return vtableItem;
 }
 
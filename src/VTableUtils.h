@@ -28,6 +28,7 @@
 
 #include <systemd/sd-bus.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -38,6 +39,7 @@ sd_bus_vtable createVTableMethodItem( const char *member
                                     , const char *signature
                                     , const char *result
                                     , sd_bus_message_handler_t handler
+                                    , size_t offset
                                     , uint64_t flags );
 sd_bus_vtable createVTableSignalItem( const char *member
                                     , const char *signature
@@ -45,11 +47,13 @@ sd_bus_vtable createVTableSignalItem( const char *member
 sd_bus_vtable createVTablePropertyItem( const char *member
                                       , const char *signature
                                       , sd_bus_property_get_t getter
+                                      , size_t offset
                                       , uint64_t flags );
 sd_bus_vtable createVTableWritablePropertyItem( const char *member
                                               , const char *signature
                                               , sd_bus_property_get_t getter
                                               , sd_bus_property_set_t setter
+                                              , size_t offset
                                               , uint64_t flags );
 sd_bus_vtable createVTableEndItem();
 
@@ -0,0 +1,284 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file WaitBackend.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WaitBackend.h"
+#include <sdbus-c++/IConnection.h>
+#include <sdbus-c++/Error.h>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+
+#if defined(IORING_FEAT_EXT_ARG) && defined(IORING_POLL_ADD_MULTI) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define SDBUS_HAVE_IO_URING 1
+#endif
+
+namespace sdbus { namespace internal {
+
+namespace {
+    int getPollTimeout(const ISdBus::PollData& pollData)
+    {
+        // sd-bus timeout is an absolute time point, poll wants a relative one
+        sdbus::IConnection::PollData sdbusPollData{pollData.fd, pollData.events, pollData.timeout_usec};
+        return sdbusPollData.getPollTimeout();
+    }
+}
+
+PollWaitBackend::PollWaitBackend(int exitFd, int wakeUpFd)
+    : exitFd_(exitFd)
+    , wakeUpFd_(wakeUpFd)
+{
+    assert(exitFd_ >= 0);
+    assert(wakeUpFd_ >= 0);
+}
+
+IWaitBackend::Events PollWaitBackend::wait(const ISdBus::PollData& pollData)
+{
+    struct pollfd fds[] = {{pollData.fd, pollData.events, 0}, {exitFd_, POLLIN, 0}, {wakeUpFd_, POLLIN, 0}};
+    auto fdsCount = sizeof(fds)/sizeof(fds[0]);
+
+    auto r = poll(fds, fdsCount, getPollTimeout(pollData));
+
+    if (r < 0 && errno == EINTR)
+        return {}; // Try again
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to wait on the bus", -errno);
+
+    Events events;
+    events.exitRequested = fds[1].revents & POLLIN;
+    events.wakeUpRequested = fds[2].revents & POLLIN;
+    return events;
+}
+
+#ifdef SDBUS_HAVE_IO_URING
+
+namespace {
+    constexpr unsigned kRingEntries = 8;
+
+    int io_uring_setup(unsigned entries, io_uring_params* params)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags, void* arg, std::size_t argSize)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+    }
+
+    void* mapRing(int fd, std::size_t size, off_t offset)
+    {
+        auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+        SDBUS_THROW_ERROR_IF(ptr == MAP_FAILED, "Failed to map io_uring ring", errno);
+        return ptr;
+    }
+
+    template <typename _T>
+    _T* ringField(void* ring, uint32_t offset)
+    {
+        return reinterpret_cast<_T*>(static_cast<char*>(ring) + offset);
+    }
+}
+
+IoUringWaitBackend::IoUringWaitBackend(int exitFd, int wakeUpFd)
+    : exitFd_(exitFd)
+    , wakeUpFd_(wakeUpFd)
+{
+    assert(exitFd_ >= 0);
+    assert(wakeUpFd_ >= 0);
+
+    try
+    {
+        setUpRing();
+    }
+    catch (...)
+    {
+        tearDownRing();
+        throw;
+    }
+}
+
+IoUringWaitBackend::~IoUringWaitBackend()
+{
+    tearDownRing();
+}
+
+void IoUringWaitBackend::setUpRing()
+{
+    io_uring_params params{};
+    ringFd_ = io_uring_setup(kRingEntries, &params);
+    SDBUS_THROW_ERROR_IF(ringFd_ < 0, "Failed to set up io_uring", errno);
+
+    // Waiting with a timeout in a single io_uring_enter call needs extended arguments (Linux 5.11)
+    SDBUS_THROW_ERROR_IF(!(params.features & IORING_FEAT_EXT_ARG), "io_uring lacks extended wait arguments", ENOTSUP);
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    sqRing_ = mapRing(ringFd_, sqRingSize_, IORING_OFF_SQ_RING);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    cqRing_ = mapRing(ringFd_, cqRingSize_, IORING_OFF_CQ_RING);
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(mapRing(ringFd_, sqesSize_, IORING_OFF_SQES));
+
+    sqHead_ = ringField<unsigned>(sqRing_, params.sq_off.head);
+    sqTail_ = ringField<unsigned>(sqRing_, params.sq_off.tail);
+    sqMask_ = ringField<unsigned>(sqRing_, params.sq_off.ring_mask);
+    sqArray_ = ringField<unsigned>(sqRing_, params.sq_off.array);
+    cqHead_ = ringField<unsigned>(cqRing_, params.cq_off.head);
+    cqTail_ = ringField<unsigned>(cqRing_, params.cq_off.tail);
+    cqMask_ = ringField<unsigned>(cqRing_, params.cq_off.ring_mask);
+    cqes_ = ringField<io_uring_cqe>(cqRing_, params.cq_off.cqes);
+}
+
+void IoUringWaitBackend::tearDownRing()
+{
+    if (sqes_ != nullptr)
+        munmap(sqes_, sqesSize_);
+    if (cqRing_ != nullptr)
+        munmap(cqRing_, cqRingSize_);
+    if (sqRing_ != nullptr)
+        munmap(sqRing_, sqRingSize_);
+    if (ringFd_ >= 0)
+        close(ringFd_); // Cancels all armed poll requests
+}
+
+IWaitBackend::Events IoUringWaitBackend::wait(const ISdBus::PollData& pollData)
+{
+    armPendingRequests(pollData);
+
+    auto timeoutMs = getPollTimeout(pollData);
+    __kernel_timespec timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000000LL};
+    io_uring_getevents_arg arg{};
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = timeoutMs >= 0 ? reinterpret_cast<uint64_t>(&timeout) : 0;
+
+    auto toSubmit = *sqTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+    auto r = io_uring_enter(ringFd_, toSubmit, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+
+    // Timeout, interrupt or temporary shortage of kernel resources; the caller processes the bus and retries
+    if (r < 0 && (errno == ETIME || errno == EINTR || errno == EAGAIN || errno == EBUSY))
+        return reapCompletions();
+
+    SDBUS_THROW_ERROR_IF(r < 0, "Failed to wait on the bus", errno);
+
+    return reapCompletions();
+}
+
+void IoUringWaitBackend::armPendingRequests(const ISdBus::PollData& pollData)
+{
+    assert(busFd_ < 0 || busFd_ == pollData.fd);
+    busFd_ = pollData.fd;
+
+    // Incoming data is watched permanently. Writability is only of interest
+    // while sd-bus has outgoing messages queued, so it is watched on demand.
+    if (!armed_[eBusIn])
+        armPollRequest(eBusIn, busFd_, POLLIN, multishotSupported_);
+    if ((pollData.events & POLLOUT) && !armed_[eBusOut])
+        armPollRequest(eBusOut, busFd_, POLLOUT, false);
+    if (!armed_[eExit])
+        armPollRequest(eExit, exitFd_, POLLIN, multishotSupported_);
+    if (!armed_[eWakeUp])
+        armPollRequest(eWakeUp, wakeUpFd_, POLLIN, multishotSupported_);
+}
+
+void IoUringWaitBackend::armPollRequest(Request request, int fd, uint32_t events, bool multishot)
+{
+    auto tail = *sqTail_;
+    auto index = tail & *sqMask_;
+    auto& sqe = sqes_[index];
+
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_POLL_ADD;
+    sqe.fd = fd;
+#if __BYTE_ORDER == __BIG_ENDIAN
+    events = (events << 16) | (events >> 16);
+#endif
+    sqe.poll32_events = events;
+    sqe.len = multishot ? IORING_POLL_ADD_MULTI : 0;
+    sqe.user_data = request;
+
+    sqArray_[index] = index;
+    __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+
+    armed_[request] = true;
+}
+
+IWaitBackend::Events IoUringWaitBackend::reapCompletions()
+{
+    Events events;
+
+    auto head = *cqHead_;
+    auto tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+        const auto& cqe = cqes_[head & *cqMask_];
+        auto request = static_cast<Request>(cqe.user_data);
+        assert(request < eRequestCount);
+
+        if (!(cqe.flags & IORING_CQE_F_MORE))
+            armed_[request] = false; // Request is finished, re-arm it before the next wait
+
+        if (cqe.res == -EINVAL && multishotSupported_)
+            multishotSupported_ = false; // Kernels before 5.13 reject multishot poll, fall back to one-shot requests
+
+        if (cqe.res <= 0)
+            continue;
+
+        if (request == eExit)
+            events.exitRequested = true;
+        else if (request == eWakeUp)
+            events.wakeUpRequested = true;
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+
+    return events;
+}
+
+#else
+
+IoUringWaitBackend::IoUringWaitBackend(int exitFd, int wakeUpFd)
+    : exitFd_(exitFd)
+    , wakeUpFd_(wakeUpFd)
+{
+    SDBUS_THROW_ERROR("io_uring is not supported by this build", ENOTSUP);
+}
+
+IoUringWaitBackend::~IoUringWaitBackend() = default;
+
+IWaitBackend::Events IoUringWaitBackend::wait(const ISdBus::PollData&)
+{
+    assert(false);
+    return {};
+}
+
+#endif
+
+}}
@@ -0,0 +1,126 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file WaitBackend.h
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDBUS_CXX_INTERNAL_WAITBACKEND_H_
+#define SDBUS_CXX_INTERNAL_WAITBACKEND_H_
+
+#include "ISdBus.h"
+#include <cstdint>
+#include <cstddef>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace sdbus { namespace internal {
+
+    // Blocks the processing loop until the bus, the loop exit descriptor
+    // or the loop wake-up descriptor become ready, or the bus timeout elapses.
+    class IWaitBackend
+    {
+    public:
+        struct Events
+        {
+            bool exitRequested{};
+            bool wakeUpRequested{};
+        };
+
+        virtual Events wait(const ISdBus::PollData& pollData) = 0;
+
+        virtual ~IWaitBackend() = default;
+    };
+
+    // Waits with a poll() call over all three descriptors per wakeup
+    class PollWaitBackend : public IWaitBackend
+    {
+    public:
+        PollWaitBackend(int exitFd, int wakeUpFd);
+
+        Events wait(const ISdBus::PollData& pollData) override;
+
+    private:
+        int exitFd_;
+        int wakeUpFd_;
+    };
+
+    // Waits on an io_uring instance with multishot poll requests armed on the bus,
+    // the exit and the wake-up descriptors. The requests stay armed across wakeups,
+    // so a wait costs one io_uring_enter call with no poll set to be rebuilt.
+    // The constructor throws sdbus::Error if io_uring is unavailable.
+    class IoUringWaitBackend : public IWaitBackend
+    {
+    public:
+        IoUringWaitBackend(int exitFd, int wakeUpFd);
+        ~IoUringWaitBackend() override;
+
+        IoUringWaitBackend(const IoUringWaitBackend&) = delete;
+        IoUringWaitBackend& operator=(const IoUringWaitBackend&) = delete;
+
+        Events wait(const ISdBus::PollData& pollData) override;
+
+    private:
+        enum Request : uint64_t
+        {
+            eBusIn,
+            eBusOut,
+            eExit,
+            eWakeUp,
+            eRequestCount
+        };
+
+        void setUpRing();
+        void tearDownRing();
+        void armPollRequest(Request request, int fd, uint32_t events, bool multishot);
+        void armPendingRequests(const ISdBus::PollData& pollData);
+        Events reapCompletions();
+
+    private:
+        int exitFd_;
+        int wakeUpFd_;
+        int busFd_{-1};
+
+        int ringFd_{-1};
+        void* sqRing_{};
+        std::size_t sqRingSize_{};
+        void* cqRing_{};
+        std::size_t cqRingSize_{};
+        io_uring_sqe* sqes_{};
+        std::size_t sqesSize_{};
+
+        unsigned* sqHead_{};
+        unsigned* sqTail_{};
+        unsigned* sqMask_{};
+        unsigned* sqArray_{};
+        unsigned* cqHead_{};
+        unsigned* cqTail_{};
+        unsigned* cqMask_{};
+        io_uring_cqe* cqes_{};
+
+        bool multishotSupported_{true};
+        bool armed_[eRequestCount]{};
+    };
+
+}}
+
+#endif /* SDBUS_CXX_INTERNAL_WAITBACKEND_H_ */
@@ -82,8 +82,7 @@ std::string AdaptorGenerator::processInterface(Node& interface) const
             << "public:" << endl
             << tab << "static constexpr const char* interfaceName = \"" << ifaceName << "\";" << endl << endl
             << "protected:" << endl
-            << tab << className << "(sdbus::IObject& object)" << endl
-            << tab << tab << ": object_(object)" << endl;
+            << tab << className;
 
     Nodes methods = interface["method"];
     Nodes signals = interface["signal"];
@@ -113,8 +112,8 @@ std::string AdaptorGenerator::processInterface(Node& interface) const
         annotationRegistration = str.str();
     }
 
-    std::string methodRegistration, methodDeclaration;
-    std::tie(methodRegistration, methodDeclaration) = processMethods(methods);
+    std::string methodRegistration, methodDeclaration, methodExecutorSetting;
+    std::tie(methodRegistration, methodDeclaration, methodExecutorSetting) = processMethods(methods);
 
     std::string signalRegistration, signalMethods;
     std::tie(signalRegistration, signalMethods) = processSignals(signals);
@@ -122,9 +121,24 @@ std::string AdaptorGenerator::processInterface(Node& interface) const
     std::string propertyRegistration, propertyAccessorDeclaration;
     std::tie(propertyRegistration, propertyAccessorDeclaration) = processProperties(properties);
 
+    // The executor parameter is named only if some method is to be executed on it
+    body << "(sdbus::IObject& object, sdbus::IExecutor* " << (methodExecutorSetting.empty() ? "" : "executor ") << "= nullptr)" << endl
+         << tab << tab << ": object_(object)" << endl;
+
+    if (!methodExecutorSetting.empty())
+    {
+        std::stringstream str;
+        str << tab << tab << "if (executor != nullptr)" << endl
+            << tab << tab << "{" << endl
+            << methodExecutorSetting
+            << tab << tab << "}" << endl;
+        methodExecutorSetting = str.str();
+    }
+
     body << tab << "{" << endl
                        << annotationRegistration
                        << methodRegistration
+                       << methodExecutorSetting
                        << signalRegistration
                        << propertyRegistration
          << tab << "}" << endl << endl;
@@ -153,9 +167,9 @@ std::string AdaptorGenerator::processInterface(Node& interface) const
 }
 
 
-std::tuple<std::string, std::string> AdaptorGenerator::processMethods(const Nodes& methods) const
+std::tuple<std::string, std::string, std::string> AdaptorGenerator::processMethods(const Nodes& methods) const
 {
-    std::ostringstream registrationSS, declarationSS;
+    std::ostringstream registrationSS, declarationSS, executorSS;
 
     for (const auto& method : methods)
     {
@@ -184,6 +198,11 @@ std::tuple<std::string, std::string> AdaptorGenerator::processMethods(const Node
                 if (annotationValue == "server" || annotationValue == "clientserver")
                     async = true;
             }
+            else if (annotationName == "org.sdbuscpp.Method.Executor")
+            {
+                if (annotationValue == "true")
+                    executorSS << tab << tab << tab << "object_.setMethodExecutor(interfaceName, \"" << methodName << "\", *executor);" << endl;
+            }
             else if (annotationName == "org.freedesktop.systemd1.Privileged")
             {
                 if (annotationValue == "true")
@@ -227,7 +246,7 @@ std::tuple<std::string, std::string> AdaptorGenerator::processMethods(const Node
                 << ") = 0;" << endl;
     }
 
-    return std::make_tuple(registrationSS.str(), declarationSS.str());
+    return std::make_tuple(registrationSS.str(), declarationSS.str(), executorSS.str());
 }
 
 
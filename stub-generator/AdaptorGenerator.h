@@ -56,9 +56,9 @@ private:
     /**
      * Generate source code for methods
      * @param methods
-     * @return tuple: registration of methods, declaration of abstract methods
+     * @return tuple: registration of methods, declaration of abstract methods, setting of method executors
      */
-    std::tuple<std::string, std::string> processMethods(const sdbuscpp::xml::Nodes& methods) const;
+    std::tuple<std::string, std::string, std::string> processMethods(const sdbuscpp::xml::Nodes& methods) const;
 
     /**
      * Generate source code for signals
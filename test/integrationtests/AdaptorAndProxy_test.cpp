@@ -44,9 +44,11 @@
 #include <chrono>
 #include <fstream>
 #include <future>
+#include <vector>
 
 using ::testing::Eq;
 using ::testing::Gt;
+using ::testing::Lt;
 using ::testing::ElementsAre;
 using namespace std::chrono_literals;
 
@@ -107,6 +109,49 @@ TEST(AdaptorAndProxy, CanBeConstructedSuccesfully)
     connection->releaseName(INTERFACE_NAME);
 }
 
+TEST(AdaptorAndProxy, HandlesMethodCallsInWorkerThreadsWhenMultithreadedDispatchIsEnabled)
+{
+    auto connection = sdbus::createConnection();
+    connection->enableMultithreadedDispatch(2);
+    connection->requestName(INTERFACE_NAME);
+    connection->enterProcessingLoopAsync();
+
+    {
+        TestingAdaptor adaptor(*connection);
+        TestingProxy proxy(INTERFACE_NAME, OBJECT_PATH);
+
+        ASSERT_THAT(proxy.doOperation(10), Eq(10));
+        ASSERT_THROW(proxy.throwError(), sdbus::Error);
+    }
+
+    connection->leaveProcessingLoop();
+    connection->releaseName(INTERFACE_NAME);
+}
+
+TEST(AdaptorAndProxy, CanDestroyLastProxyOfSharedConnectionInItsCallback)
+{
+    auto connection = sdbus::createConnection();
+    connection->requestName(INTERFACE_NAME);
+    connection->enterProcessingLoopAsync();
+
+    {
+        TestingAdaptor adaptor(*connection);
+        auto proxy = sdbus::createObjectProxy(INTERFACE_NAME, OBJECT_PATH);
+        std::promise<void> promise;
+
+        proxy->callMethodAsync("doOperation").onInterface(INTERFACE_NAME).withArguments(uint32_t{1}).uponReplyInvoke([&](const sdbus::Error* /*error*/, uint32_t /*result*/)
+        {
+            proxy.reset();
+            promise.set_value();
+        });
+
+        ASSERT_THAT(promise.get_future().wait_for(500ms), Eq(std::future_status::ready));
+    }
+
+    connection->leaveProcessingLoop();
+    connection->releaseName(INTERFACE_NAME);
+}
+
 // Methods
 
 using SdbusTestObject = AdaptorAndProxyFixture;
@@ -302,6 +347,161 @@ TEST_F(SdbusTestObject, HandlesCorrectlyABulkOfParallelServerSideAsyncMethods)
     ASSERT_THAT(resultCount, Eq(1500));
 }
 
+TEST_F(SdbusTestObject, ServesManyProxiesCreatedWithoutExplicitConnection)
+{
+    std::vector<std::unique_ptr<TestingProxy>> proxies;
+    for (int i = 0; i < 100; ++i)
+        proxies.push_back(std::make_unique<TestingProxy>(INTERFACE_NAME, OBJECT_PATH));
+
+    for (auto& proxy : proxies)
+        ASSERT_THAT(proxy->multiply(INT64_VALUE, DOUBLE_VALUE), Eq(INT64_VALUE * DOUBLE_VALUE));
+}
+
+TEST_F(SdbusTestObject, RunsSynchronousMethodCallsFromMultipleThreadsConcurrently)
+{
+    auto call = [this](){ return m_proxy->doOperationAsync(500); };
+
+    auto start = std::chrono::steady_clock::now();
+    std::future<uint32_t> results[]{std::async(std::launch::async, call), std::async(std::launch::async, call), std::async(std::launch::async, call)};
+    std::for_each(std::begin(results), std::end(results), [](auto& r){ ASSERT_THAT(r.get(), Eq(500)); });
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    ASSERT_THAT(duration, Lt(1200ms));
+}
+
+TEST_F(SdbusTestObject, SpreadsMethodCallsOfProxyUponConnectionPool)
+{
+    auto pool = sdbus::createConnectionPool(3);
+    TestingProxy proxy(*pool, INTERFACE_NAME, OBJECT_PATH);
+
+    auto call = [&proxy](){ return proxy.multiply(INT64_VALUE, DOUBLE_VALUE); };
+    std::vector<std::future<double>> results;
+    for (int i = 0; i < 6; ++i)
+        results.push_back(std::async(std::launch::async, call));
+
+    for (auto& result : results)
+        ASSERT_THAT(result.get(), Eq(INT64_VALUE * DOUBLE_VALUE));
+}
+
+TEST_F(SdbusTestObject, ReceivesSignalsOnProxyUponConnectionPool)
+{
+    auto pool = sdbus::createConnectionPool(2);
+    TestingProxy proxy(*pool, INTERFACE_NAME, OBJECT_PATH, sdbus::IConnectionPool::CallDistribution::ePerObject);
+    std::this_thread::sleep_for(50ms); // Give time for the proxy to start listening to signals
+
+    m_adaptor->simpleSignal();
+    std::this_thread::sleep_for(50ms);
+
+    ASSERT_THAT(proxy.getSimpleCallCount(), Eq(1));
+    ASSERT_THAT(proxy.doOperation(100), Eq(100));
+}
+
+TEST_F(SdbusTestObject, ThrowsTimeoutErrorWhenMethodCallTimesOut)
+{
+    auto proxy = sdbus::createObjectProxy(INTERFACE_NAME, OBJECT_PATH);
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t result{};
+    ASSERT_THROW(proxy->callMethod("doOperationAsync").onInterface(INTERFACE_NAME).withTimeout(50ms).withArguments(uint32_t{1000}).storeResultsTo(result), sdbus::Error);
+
+    ASSERT_THAT(std::chrono::steady_clock::now() - start, Lt(500ms));
+}
+
+TEST_F(SdbusTestObject, AppliesProxyMethodCallTimeoutToCallsWithoutTheirOwnTimeout)
+{
+    auto proxy = sdbus::createObjectProxy(INTERFACE_NAME, OBJECT_PATH);
+    proxy->setMethodCallTimeout(50ms);
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t result{};
+    ASSERT_THROW(proxy->callMethod("doOperationAsync").onInterface(INTERFACE_NAME).withArguments(uint32_t{1000}).storeResultsTo(result), sdbus::Error);
+
+    ASSERT_THAT(std::chrono::steady_clock::now() - start, Lt(500ms));
+}
+
+TEST_F(SdbusTestObject, FailsPendingMethodCallWhenProxyProcessingLoopExits)
+{
+    auto connection = sdbus::createConnection();
+    auto proxy = sdbus::createObjectProxy(*connection, INTERFACE_NAME, OBJECT_PATH);
+    connection->enterProcessingLoopAsync();
+
+    auto future = std::async(std::launch::async, [&]()
+    {
+        uint32_t result{};
+        proxy->callMethod("doOperationAsync").onInterface(INTERFACE_NAME).withArguments(uint32_t{1000}).storeResultsTo(result);
+    });
+    std::this_thread::sleep_for(100ms); // Give time for the call to get in flight
+    connection->leaveProcessingLoop();
+
+    ASSERT_THAT(future.wait_for(500ms), Eq(std::future_status::ready));
+    ASSERT_THROW(future.get(), sdbus::Error);
+}
+
+TEST_F(SdbusTestObject, InvokesAsyncReplyHandlerWithErrorWhenMethodCallTimesOut)
+{
+    auto proxy = sdbus::createObjectProxy(INTERFACE_NAME, OBJECT_PATH);
+    std::promise<bool> promise;
+
+    proxy->callMethodAsync("doOperationAsync").onInterface(INTERFACE_NAME).withTimeout(50ms).withArguments(uint32_t{1000}).uponReplyInvoke([&](const sdbus::Error* error, uint32_t /*result*/)
+    {
+        promise.set_value(error != nullptr);
+    });
+
+    auto future = promise.get_future();
+    ASSERT_THAT(future.wait_for(500ms), Eq(std::future_status::ready));
+    ASSERT_TRUE(future.get());
+}
+
+TEST_F(SdbusTestObject, DoesNotInvokeReplyHandlerOfCancelledAsyncCall)
+{
+    auto proxy = sdbus::createObjectProxy(INTERFACE_NAME, OBJECT_PATH);
+    std::atomic<bool> invoked{false};
+
+    auto call = proxy->callMethodAsync("doOperationAsync").onInterface(INTERFACE_NAME).withArguments(uint32_t{100}).uponReplyInvoke([&](const sdbus::Error* /*error*/, uint32_t /*result*/)
+    {
+        invoked = true;
+    });
+    ASSERT_TRUE(call.isPending());
+
+    call.cancel();
+
+    ASSERT_FALSE(call.isPending());
+    std::this_thread::sleep_for(300ms);
+    ASSERT_FALSE(invoked);
+}
+
+TEST_F(SdbusTestObject, CancelsPendingAsyncCallsWhenProxyIsDestroyed)
+{
+    auto proxy = sdbus::createObjectProxy(INTERFACE_NAME, OBJECT_PATH);
+    std::atomic<bool> invoked{false};
+
+    auto call = proxy->callMethodAsync("doOperationAsync").onInterface(INTERFACE_NAME).withArguments(uint32_t{100}).uponReplyInvoke([&](const sdbus::Error* /*error*/, uint32_t /*result*/)
+    {
+        invoked = true;
+    });
+    proxy.reset();
+
+    ASSERT_FALSE(call.isPending());
+    std::this_thread::sleep_for(300ms);
+    ASSERT_FALSE(invoked);
+    call.cancel(); // No-op on a stale handle
+}
+
+TEST_F(SdbusTestObject, AsyncCallIsNoLongerPendingAfterItsReplyArrived)
+{
+    auto proxy = sdbus::createObjectProxy(INTERFACE_NAME, OBJECT_PATH);
+    std::promise<uint32_t> promise;
+    auto future = promise.get_future();
+
+    auto call = proxy->callMethodAsync("doOperationAsync").onInterface(INTERFACE_NAME).withArguments(uint32_t{10}).uponReplyInvoke([&](const sdbus::Error* /*error*/, uint32_t result)
+    {
+        promise.set_value(result);
+    });
+
+    ASSERT_THAT(future.get(), Eq(10u));
+    ASSERT_FALSE(call.isPending());
+}
+
 TEST_F(SdbusTestObject, InvokesMethodAsynchronouslyOnClientSide)
 {
     std::promise<uint32_t> promise;
@@ -336,6 +536,24 @@ TEST_F(SdbusTestObject, InvokesErroneousMethodAsynchronouslyOnClientSide)
     ASSERT_THROW(future.get(), sdbus::Error);
 }
 
+TEST_F(SdbusTestObject, DeliversAsyncMethodResultThroughFuture)
+{
+    auto proxy = sdbus::createObjectProxy(INTERFACE_NAME, OBJECT_PATH);
+
+    auto future = proxy->callMethodAsync("doOperationAsync").onInterface(INTERFACE_NAME).withArguments(uint32_t{100}).getResultAsFuture<uint32_t>();
+
+    ASSERT_THAT(future.get(), Eq(100u));
+}
+
+TEST_F(SdbusTestObject, DeliversAsyncMethodErrorThroughFuture)
+{
+    auto proxy = sdbus::createObjectProxy(INTERFACE_NAME, OBJECT_PATH);
+
+    auto future = proxy->callMethodAsync("throwError").onInterface(INTERFACE_NAME).getResultAsFuture<>();
+
+    ASSERT_THROW(future.get(), sdbus::Error);
+}
+
 TEST_F(SdbusTestObject, FailsCallingNonexistentMethod)
 {
     ASSERT_THROW(m_proxy->callNonexistentMethod(), sdbus::Error);
@@ -369,6 +587,35 @@ TEST_F(SdbusTestObject, EmitsSimpleSignalSuccesfully)
     ASSERT_THAT(m_proxy->getSimpleCallCount(), Eq(count + 1));
 }
 
+TEST_F(SdbusTestObject, ReceivesSignalEmittedRightAfterProxyIsConstructed)
+{
+    TestingProxy proxy(*s_connection, INTERFACE_NAME, OBJECT_PATH);
+
+    m_adaptor->simpleSignal();
+    usleep(10000);
+
+    ASSERT_THAT(proxy.getSimpleCallCount(), Eq(1));
+}
+
+TEST_F(SdbusTestObject, ReceivesSignalsOnlyWhileTheirHandlersAreEnabledUnderLazySubscription)
+{
+    TestingProxy proxy(*s_connection, INTERFACE_NAME, OBJECT_PATH, sdbus::IObjectProxy::SignalSubscription::eLazy);
+
+    m_adaptor->simpleSignal();
+    usleep(10000);
+    ASSERT_THAT(proxy.getSimpleCallCount(), Eq(0));
+
+    proxy.enableSimpleSignal();
+    m_adaptor->simpleSignal();
+    usleep(10000);
+    ASSERT_THAT(proxy.getSimpleCallCount(), Eq(1));
+
+    proxy.disableSimpleSignal();
+    m_adaptor->simpleSignal();
+    usleep(10000);
+    ASSERT_THAT(proxy.getSimpleCallCount(), Eq(1));
+}
+
 TEST_F(SdbusTestObject, EmitsSignalWithMapSuccesfully)
 {
     m_adaptor->signalWithMap({{0, "zero"}, {1, "one"}});
@@ -29,6 +29,10 @@
 // sdbus
 #include <sdbus-c++/Error.h>
 #include <sdbus-c++/IConnection.h>
+#include <sdbus-c++/IObject.h>
+#include <sdbus-c++/IObjectProxy.h>
+#include <sdbus-c++/ConvenienceClasses.h>
+#include <sdbus-c++/IExecutor.h>
 
 // gmock
 #include <gtest/gtest.h>
@@ -36,8 +40,59 @@
 
 // STL
 #include <thread>
+#include <string>
+#include <vector>
+#include <future>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <memory>
+
+// POSIX
+#include <sys/socket.h>
 
 using ::testing::Eq;
+using ::testing::Ne;
+
+namespace
+{
+    // A server and a client connected directly over a socket pair, no bus daemon involved
+    class DirectlyConnectedPeers : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            int fds[2];
+            ASSERT_THAT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds), Eq(0));
+            serverConnection_ = sdbus::createServerConnection(fds[0]);
+            clientConnection_ = sdbus::createDirectConnection(fds[1]);
+        }
+
+        void startLoops()
+        {
+            serverConnection_->enterProcessingLoopAsync();
+            clientConnection_->enterProcessingLoopAsync();
+        }
+
+        void TearDown() override
+        {
+            clientConnection_->leaveProcessingLoop();
+            serverConnection_->leaveProcessingLoop();
+        }
+
+        std::unique_ptr<sdbus::IConnection> serverConnection_;
+        std::unique_ptr<sdbus::IConnection> clientConnection_;
+    };
+
+    using DirectConnection = DirectlyConnectedPeers;
+    using ConnectionWithOutboundQueue = DirectlyConnectedPeers;
+    using CorkedObject = DirectlyConnectedPeers;
+    using ConnectionWithWriteQueueLimit = DirectlyConnectedPeers;
+    using ObjectWithMethodExecutor = DirectlyConnectedPeers;
+    using ProxyWithMultithreadedDispatch = DirectlyConnectedPeers;
+    using ConnectionWithMultithreadedDispatch = DirectlyConnectedPeers;
+    using DirectlyConnectedObjectWithMaxMethodCallQueueAge = DirectlyConnectedPeers;
+}
 
 
 /*-------------------------------------*/
@@ -63,6 +118,19 @@ TEST(Connection, CannotRequestNonregisteredDbusName)
     ASSERT_THROW(connection->requestName("some.random.not.supported.dbus.name"), sdbus::Error);
 }
 
+TEST(Connection, CanBeCreatedWithRegisteredDbusName)
+{
+    std::unique_ptr<sdbus::IConnection> connection;
+
+    ASSERT_NO_THROW(connection = sdbus::createConnection(INTERFACE_NAME));
+    ASSERT_THROW(connection->requestName(INTERFACE_NAME), sdbus::Error); // Already ours
+}
+
+TEST(Connection, CannotBeCreatedWithNonregisteredDbusName)
+{
+    ASSERT_THROW(sdbus::createConnection("some.random.not.supported.dbus.name"), sdbus::Error);
+}
+
 TEST(Connection, CanReleasedRequestedName)
 {
     auto connection = sdbus::createConnection();
@@ -89,3 +157,445 @@ TEST(Connection, CanEnterAndLeaveProcessingLoop)
 
     connection->releaseName(INTERFACE_NAME);
 }
+
+TEST(Connection, FailsSignalSubscriptionRefusedByBusDaemonWithoutProcessingLoop)
+{
+    auto connection = sdbus::createConnection();
+    auto proxy = sdbus::createObjectProxy(*connection, INTERFACE_NAME, OBJECT_PATH);
+    // The daemon refuses the match rule, as it is not a valid namespace
+    proxy->uponSignal("signal").onInterface(INTERFACE_NAME).whereArgument0Namespace("org..sdbuscpp").call([](const std::string&){});
+
+    ASSERT_THROW(proxy->finishRegistration(), sdbus::Error);
+}
+
+TEST(Connection, CanEnterAndLeaveProcessingLoopWithIoUringBackend)
+{
+    auto connection = sdbus::createConnection();
+    connection->setEventLoopBackend(sdbus::IConnection::EventLoopBackend::eIoUring);
+
+    std::thread t([&](){ connection->enterProcessingLoop(); });
+    connection->leaveProcessingLoop();
+
+    t.join();
+}
+
+TEST(Connection, ServesMethodCallsWithIoUringBackend)
+{
+    auto connection = sdbus::createConnection();
+    connection->setEventLoopBackend(sdbus::IConnection::EventLoopBackend::eIoUring);
+    connection->enterProcessingLoopAsync();
+
+    auto proxy = sdbus::createObjectProxy(*connection, "org.freedesktop.DBus", "/org/freedesktop/DBus");
+    std::string id;
+    ASSERT_NO_THROW(proxy->callMethod("GetId").onInterface("org.freedesktop.DBus").storeResultsTo(id));
+    ASSERT_FALSE(id.empty());
+
+    connection->leaveProcessingLoop();
+}
+
+TEST(Connection, DeliversOnlySignalsPassingArgumentAndPathNamespaceFilter)
+{
+    auto serverConnection = sdbus::createConnection();
+    auto clientConnection = sdbus::createConnection();
+    clientConnection->enterProcessingLoopAsync();
+
+    std::vector<std::unique_ptr<sdbus::IObject>> objects;
+    for (const auto* path : {"/org/sdbuscpp/devices/1", "/org/sdbuscpp/devices/7", "/org/sdbuscpp/other"})
+    {
+        objects.push_back(sdbus::createObject(*serverConnection, path));
+        objects.back()->registerSignal("changed").onInterface("org.sdbuscpp.devices").withParameters<std::string, uint32_t>();
+        objects.back()->finishRegistration();
+    }
+
+    auto proxy = sdbus::createObjectProxy(*clientConnection, "", "/org/sdbuscpp/devices");
+    std::vector<std::string> received;
+    std::promise<void> lastReceived;
+    proxy->uponSignal("changed").onInterface("org.sdbuscpp.devices").whereArgument(0, "dev7").inPathNamespace().call([&](const std::string& id, uint32_t state)
+    {
+        received.push_back(id);
+        if (state == 3)
+            lastReceived.set_value();
+    });
+    proxy->finishRegistration();
+
+    objects[0]->emitSignal("changed").onInterface("org.sdbuscpp.devices").withArguments(std::string{"dev1"}, uint32_t{1}); // Wrong argument
+    objects[2]->emitSignal("changed").onInterface("org.sdbuscpp.devices").withArguments(std::string{"dev7"}, uint32_t{2}); // Out of namespace
+    objects[1]->emitSignal("changed").onInterface("org.sdbuscpp.devices").withArguments(std::string{"dev7"}, uint32_t{3});
+
+    ASSERT_THAT(lastReceived.get_future().wait_for(std::chrono::seconds(2)), Eq(std::future_status::ready));
+    ASSERT_THAT(received, ::testing::ElementsAre("dev7"));
+
+    clientConnection->leaveProcessingLoop();
+}
+
+TEST(Connection, RoutesDemultiplexedSignalsToProxiesOfTheirObjects)
+{
+    auto serverConnection = sdbus::createConnection();
+    auto clientConnection = sdbus::createConnection();
+    clientConnection->enableSignalDemultiplexing();
+    clientConnection->enterProcessingLoopAsync();
+
+    constexpr uint32_t objectCount = 8;
+    std::vector<std::unique_ptr<sdbus::IObject>> objects;
+    std::vector<std::unique_ptr<sdbus::IObjectProxy>> proxies;
+    std::vector<std::promise<uint32_t>> received(objectCount);
+    for (uint32_t i = 0; i < objectCount; ++i)
+    {
+        auto path = "/org/sdbuscpp/devices/" + std::to_string(i);
+        objects.push_back(sdbus::createObject(*serverConnection, path));
+        objects.back()->registerSignal("changed").onInterface("org.sdbuscpp.devices").withParameters<uint32_t>();
+        objects.back()->finishRegistration();
+
+        proxies.push_back(sdbus::createObjectProxy(*clientConnection, "", path));
+        proxies.back()->uponSignal("changed").onInterface("org.sdbuscpp.devices").call([&received, i](uint32_t id)
+        {
+            received[i].set_value(id);
+        });
+        proxies.back()->finishRegistration();
+    }
+    // Proxies gone before the signal arrives must not be called, nor keep others from being called
+    proxies[0].reset();
+
+    for (uint32_t i = objectCount; i-- > 0;)
+        objects[i]->emitSignal("changed").onInterface("org.sdbuscpp.devices").withArguments(i);
+
+    for (uint32_t i = 1; i < objectCount; ++i)
+    {
+        auto future = received[i].get_future();
+        ASSERT_THAT(future.wait_for(std::chrono::seconds(2)), Eq(std::future_status::ready));
+        ASSERT_THAT(future.get(), Eq(i));
+    }
+
+    clientConnection->leaveProcessingLoop();
+}
+
+TEST_F(DirectConnection, ServesMethodCallsAndSignalsWithoutBusDaemon)
+{
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/direct");
+    object->registerMethod("Concatenate").onInterface("org.sdbuscpp.direct").implementedAs([](const std::string& a, const std::string& b){ return a + b; });
+    object->registerSignal("Concatenated").onInterface("org.sdbuscpp.direct").withParameters<std::string>();
+    object->finishRegistration();
+
+    std::promise<std::string> signalPromise;
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/direct");
+    proxy->uponSignal("Concatenated").onInterface("org.sdbuscpp.direct").call([&](const std::string& s){ signalPromise.set_value(s); });
+    proxy->finishRegistration();
+    startLoops();
+
+    std::string result;
+    proxy->callMethod("Concatenate").onInterface("org.sdbuscpp.direct").withArguments("peer", "2peer").storeResultsTo(result);
+    ASSERT_THAT(result, Eq("peer2peer"));
+
+    object->emitSignal("Concatenated").onInterface("org.sdbuscpp.direct").withArguments(result);
+    auto signalFuture = signalPromise.get_future();
+    ASSERT_THAT(signalFuture.wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+    ASSERT_THAT(signalFuture.get(), Eq("peer2peer"));
+}
+
+TEST_F(DirectConnection, DispatchesCallsToMethodsAndPropertiesOfTheSameNameOnTheirInterfaces)
+{
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/direct");
+    uint32_t level = 1;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        auto interfaceName = "org.sdbuscpp.direct" + std::to_string(i);
+        object->registerMethod("Get").onInterface(interfaceName).implementedAs([i](){ return i; });
+        object->registerProperty("level").onInterface(interfaceName).withGetter([&level, i](){ return level + i; })
+                                                                    .withSetter([&level, i](const uint32_t& value){ level = value - i; });
+    }
+    object->finishRegistration();
+
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/direct");
+    startLoops();
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        uint32_t result{};
+        proxy->callMethod("Get").onInterface("org.sdbuscpp.direct" + std::to_string(i)).storeResultsTo(result);
+        ASSERT_THAT(result, Eq(i));
+    }
+    proxy->setProperty("level").onInterface("org.sdbuscpp.direct2").toValue(uint32_t{12});
+    ASSERT_THAT(proxy->getProperty("level").onInterface("org.sdbuscpp.direct1").get<uint32_t>(), Eq(11u));
+}
+
+TEST_F(ConnectionWithOutboundQueue, DeliversRepliesAndSignalsSentFromOtherThreadsInOrder)
+{
+    serverConnection_->enableOutboundQueue();
+
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/direct");
+    std::vector<std::thread> workers;
+    object->registerMethod("count").onInterface("org.sdbuscpp.direct").implementedAs([&](sdbus::Result<>&& result, uint32_t n)
+    {
+        workers.emplace_back([&object = *object, result = std::move(result), n]()
+        {
+            for (uint32_t i = 0; i < n; ++i)
+                object.emitSignal("counted").onInterface("org.sdbuscpp.direct").withArguments(i);
+            result.returnResults();
+        });
+    });
+    object->registerSignal("counted").onInterface("org.sdbuscpp.direct").withParameters<uint32_t>();
+    object->finishRegistration();
+
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/direct");
+    std::vector<uint32_t> counted;
+    proxy->uponSignal("counted").onInterface("org.sdbuscpp.direct").call([&](uint32_t i){ counted.push_back(i); });
+    proxy->finishRegistration();
+    startLoops();
+
+    std::promise<void> replyPromise;
+    proxy->callMethodAsync("count").onInterface("org.sdbuscpp.direct").withArguments(uint32_t{100}).uponReplyInvoke([&](const sdbus::Error* error){ if (error == nullptr) replyPromise.set_value(); });
+
+    // Signals and the reply come from one thread, so the reply arrives after all the signals
+    ASSERT_THAT(replyPromise.get_future().wait_for(std::chrono::seconds(2)), Eq(std::future_status::ready));
+    ASSERT_THAT(counted.size(), Eq(100u));
+    for (uint32_t i = 0; i < counted.size(); ++i)
+        ASSERT_THAT(counted[i], Eq(i));
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+TEST_F(CorkedObject, EmitsHeldBackSignalsInOrderWhenUncorked)
+{
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/direct");
+    object->registerSignal("counted").onInterface("org.sdbuscpp.direct").withParameters<uint32_t>();
+    object->finishRegistration();
+
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/direct");
+    std::atomic<uint32_t> counted{};
+    std::atomic<bool> inOrder{true};
+    std::promise<void> allCounted;
+    proxy->uponSignal("counted").onInterface("org.sdbuscpp.direct").call([&](uint32_t i)
+    {
+        if (i != counted)
+            inOrder = false;
+        if (++counted == 100)
+            allCounted.set_value();
+    });
+    proxy->finishRegistration();
+    startLoops();
+
+    {
+        sdbus::ScopedCork cork{*object};
+        for (uint32_t i = 0; i < 100; ++i)
+            object->emitSignal("counted").onInterface("org.sdbuscpp.direct").withArguments(i);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ASSERT_THAT(counted.load(), Eq(0u));
+    }
+
+    ASSERT_THAT(allCounted.get_future().wait_for(std::chrono::seconds(2)), Eq(std::future_status::ready));
+    ASSERT_TRUE(inOrder);
+}
+
+TEST_F(ConnectionWithWriteQueueLimit, RefusesSignalsWhileCongestedAndNotifiesAboutRecovery)
+{
+    serverConnection_->setWriteQueueLimit(4, sdbus::IConnection::OverflowPolicy::eFailFast);
+    std::atomic<bool> congested{};
+    std::promise<void> recovered;
+    serverConnection_->setWriteQueueWatermarks(0, 2, [&](bool isCongested)
+    {
+        congested = isCongested;
+        if (!isCongested)
+            recovered.set_value();
+    });
+
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/direct");
+    object->registerMethod("ping").onInterface("org.sdbuscpp.direct").implementedAs([](){});
+    object->registerSignal("blob").onInterface("org.sdbuscpp.direct").withParameters<std::string>();
+    object->finishRegistration();
+    serverConnection_->enterProcessingLoopAsync();
+
+    // Completes the handshake, so nothing is held back in the write queue for authentication
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/direct");
+    proxy->finishRegistration();
+    proxy->callMethod("ping").onInterface("org.sdbuscpp.direct");
+
+    // The client does not read yet, so the socket buffer fills up and messages pile up in the write queue
+    const std::string blob(64 * 1024, 'x');
+    bool refused{};
+    for (int i = 0; i < 1000 && !refused; ++i)
+    {
+        try
+        {
+            object->emitSignal("blob").onInterface("org.sdbuscpp.direct").withArguments(blob);
+        }
+        catch (const sdbus::Error&)
+        {
+            refused = true;
+        }
+    }
+    ASSERT_TRUE(refused);
+    ASSERT_TRUE(congested);
+    ASSERT_THAT(serverConnection_->getWriteQueueDepth(), Eq(4u));
+
+    clientConnection_->enterProcessingLoopAsync();
+
+    ASSERT_THAT(recovered.get_future().wait_for(std::chrono::seconds(2)), Eq(std::future_status::ready));
+    ASSERT_FALSE(congested);
+    ASSERT_THAT(serverConnection_->getWriteQueueDepth(), Eq(0u));
+}
+
+TEST_F(ObjectWithMethodExecutor, HandlesCallsInExecutorThreadsWithoutBlockingTheProcessingLoop)
+{
+    auto pool = sdbus::createThreadPool(2);
+
+    std::promise<void> releaseSlowCall;
+    auto releaseFuture = releaseSlowCall.get_future().share();
+    std::thread::id slowThread;
+    std::thread::id fastThread;
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/direct");
+    object->registerMethod("slow").onInterface("org.sdbuscpp.direct").executedOn(*pool).implementedAs([&, releaseFuture](){ slowThread = std::this_thread::get_id(); releaseFuture.wait(); });
+    object->registerMethod("fast").onInterface("org.sdbuscpp.direct").implementedAs([&](){ fastThread = std::this_thread::get_id(); });
+    object->finishRegistration();
+
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/direct");
+    proxy->finishRegistration();
+    startLoops();
+
+    std::promise<void> slowPromise;
+    proxy->callMethodAsync("slow").onInterface("org.sdbuscpp.direct").uponReplyInvoke([&](const sdbus::Error* error){ if (error == nullptr) slowPromise.set_value(); });
+    // Would time out if the slow call occupied the processing loop thread
+    proxy->callMethod("fast").onInterface("org.sdbuscpp.direct").withTimeout(std::chrono::seconds(1));
+    releaseSlowCall.set_value();
+
+    auto slowFuture = slowPromise.get_future();
+    ASSERT_THAT(slowFuture.wait_for(std::chrono::seconds(2)), Eq(std::future_status::ready));
+    ASSERT_THAT(slowThread, Ne(fastThread));
+}
+
+TEST_F(ObjectWithMethodExecutor, WaitsUponDestructionForHandlersRunningInExecutor)
+{
+    auto pool = sdbus::createThreadPool(1);
+
+    std::promise<void> started;
+    std::atomic<bool> finished{false};
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/direct");
+    object->registerMethod("slow").onInterface("org.sdbuscpp.direct").executedOn(*pool).implementedAs([&]()
+    {
+        started.set_value();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        finished = true;
+    });
+    object->finishRegistration();
+
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/direct");
+    proxy->finishRegistration();
+    startLoops();
+
+    proxy->callMethodAsync("slow").onInterface("org.sdbuscpp.direct").uponReplyInvoke([](const sdbus::Error*){});
+    ASSERT_THAT(started.get_future().wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+    object.reset();
+
+    ASSERT_TRUE(finished);
+}
+
+TEST_F(ProxyWithMultithreadedDispatch, WaitsUponDestructionForSignalHandlersRunningInWorkers)
+{
+    clientConnection_->enableMultithreadedDispatch(1);
+
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/direct");
+    object->registerSignal("tick").onInterface("org.sdbuscpp.direct");
+    object->finishRegistration();
+
+    std::promise<void> started;
+    std::atomic<bool> finished{false};
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/direct");
+    proxy->uponSignal("tick").onInterface("org.sdbuscpp.direct").call([&]()
+    {
+        started.set_value();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        finished = true;
+    });
+    proxy->finishRegistration();
+    startLoops();
+
+    object->emitSignal("tick").onInterface("org.sdbuscpp.direct");
+    ASSERT_THAT(started.get_future().wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+    proxy.reset();
+
+    ASSERT_TRUE(finished);
+}
+
+TEST_F(ConnectionWithMultithreadedDispatch, TurnsAnyExceptionOfHandlersInWorkersIntoErrors)
+{
+    serverConnection_->enableMultithreadedDispatch(1);
+    clientConnection_->enableMultithreadedDispatch(1);
+
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/direct");
+    object->registerMethod("crash").onInterface("org.sdbuscpp.direct").implementedAs([](){ throw std::runtime_error("Crashed"); });
+    object->registerSignal("tick").onInterface("org.sdbuscpp.direct").withParameters<std::string>();
+    object->registerSignal("tock").onInterface("org.sdbuscpp.direct");
+    object->finishRegistration();
+
+    std::promise<void> tocked;
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/direct");
+    proxy->uponSignal("tick").onInterface("org.sdbuscpp.direct").call([](int){ FAIL() << "Malformed signal delivered"; });
+    proxy->uponSignal("tock").onInterface("org.sdbuscpp.direct").call([&](){ tocked.set_value(); });
+    proxy->finishRegistration();
+    startLoops();
+
+    try
+    {
+        proxy->callMethod("crash").onInterface("org.sdbuscpp.direct");
+        FAIL() << "Expected an error reply";
+    }
+    catch (const sdbus::Error& e)
+    {
+        ASSERT_THAT(e.getName(), Eq("org.freedesktop.DBus.Error.Failed"));
+    }
+
+    // The tick carries a string where the handler takes an int, so it fails to deserialize
+    object->emitSignal("tick").onInterface("org.sdbuscpp.direct").withArguments(std::string("tick"));
+    object->emitSignal("tock").onInterface("org.sdbuscpp.direct");
+    ASSERT_THAT(tocked.get_future().wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+}
+
+TEST_F(DirectlyConnectedObjectWithMaxMethodCallQueueAge, DropsCallsThatWaitedTooLongForAWorker)
+{
+    serverConnection_->enableMultithreadedDispatch(1);
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/direct");
+    object->registerMethod("sleep").onInterface("org.sdbuscpp.direct").implementedAs([](uint32_t ms){ std::this_thread::sleep_for(std::chrono::milliseconds(ms)); });
+    object->registerMethod("ping").onInterface("org.sdbuscpp.direct").implementedAs([](){ return true; });
+    object->setMaxMethodCallQueueAge("org.sdbuscpp.direct", std::chrono::milliseconds(50));
+    object->setMaxMethodCallQueueAge("org.sdbuscpp.direct", "ping", 0);
+    object->finishRegistration();
+
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/direct");
+    proxy->finishRegistration();
+    startLoops();
+
+    std::promise<void> pingPromise;
+    auto ignoreReply = [](const sdbus::Error*){};
+    proxy->callMethodAsync("sleep").onInterface("org.sdbuscpp.direct").withArguments(uint32_t{300}).uponReplyInvoke(ignoreReply);
+    proxy->callMethodAsync("sleep").onInterface("org.sdbuscpp.direct").withTimeout(std::chrono::milliseconds(100)).withArguments(uint32_t{0}).uponReplyInvoke(ignoreReply);
+    proxy->callMethodAsync("sleep").onInterface("org.sdbuscpp.direct").withTimeout(std::chrono::milliseconds(100)).withArguments(uint32_t{0}).uponReplyInvoke(ignoreReply);
+    proxy->callMethodAsync("ping").onInterface("org.sdbuscpp.direct").uponReplyInvoke([&](const sdbus::Error* error, bool){ if (error == nullptr) pingPromise.set_value(); });
+
+    auto pingFuture = pingPromise.get_future();
+    ASSERT_THAT(pingFuture.wait_for(std::chrono::seconds(2)), Eq(std::future_status::ready));
+    ASSERT_THAT(object->getExpiredMethodCallCount(), Eq(2u));
+}
+
+TEST(ObjectWithMaxMethodCallQueueAge, CannotLimitQueueAgeOfCallsHandledInProcessingLoop)
+{
+    auto connection = sdbus::createConnection();
+
+    auto object = sdbus::createObject(*connection, "/org/sdbuscpp/direct");
+    object->registerMethod("ping").onInterface("org.sdbuscpp.direct").implementedAs([](){ return true; });
+    object->setMaxMethodCallQueueAge("org.sdbuscpp.direct", std::chrono::milliseconds(50));
+
+    ASSERT_THROW(object->finishRegistration(), sdbus::Error);
+}
+
+TEST(ObjectWithMaxMethodCallQueueAge, CannotSetQueueAgeAfterRegistrationIsFinished)
+{
+    auto connection = sdbus::createConnection();
+    connection->enableMultithreadedDispatch(1);
+
+    auto object = sdbus::createObject(*connection, "/org/sdbuscpp/direct");
+    object->registerMethod("ping").onInterface("org.sdbuscpp.direct").implementedAs([](){ return true; });
+    object->finishRegistration();
+
+    ASSERT_THROW(object->setMaxMethodCallQueueAge("org.sdbuscpp.direct", std::chrono::milliseconds(50)), sdbus::Error);
+}
@@ -0,0 +1,321 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file Coroutines_test.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// sdbus
+#include <sdbus-c++/Error.h>
+#include <sdbus-c++/IConnection.h>
+#include <sdbus-c++/IExecutor.h>
+#include <sdbus-c++/IObject.h>
+#include <sdbus-c++/IObjectProxy.h>
+#include <sdbus-c++/Task.h>
+
+// Built as C++20 where the compiler supports coroutines; otherwise there is nothing to test
+#ifdef SDBUS_HAS_COROUTINES
+
+// gmock
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// STL
+#include <string>
+#include <tuple>
+#include <future>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+
+// POSIX
+#include <sys/socket.h>
+
+using ::testing::Eq;
+
+namespace
+{
+    // Minimal eagerly started coroutine type for driving awaitables from the test body
+    struct FireAndForget
+    {
+        struct promise_type
+        {
+            FireAndForget get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    // A server and a client connected directly over a socket pair, both with running event loops
+    class DirectlyConnectedPeers : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            int fds[2];
+            ASSERT_THAT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds), Eq(0));
+            serverConnection_ = sdbus::createServerConnection(fds[0]);
+            clientConnection_ = sdbus::createDirectConnection(fds[1]);
+        }
+
+        void startLoops()
+        {
+            serverConnection_->enterProcessingLoopAsync();
+            clientConnection_->enterProcessingLoopAsync();
+        }
+
+        void TearDown() override
+        {
+            clientConnection_->leaveProcessingLoop();
+            serverConnection_->leaveProcessingLoop();
+        }
+
+        std::unique_ptr<sdbus::IConnection> serverConnection_;
+        std::unique_ptr<sdbus::IConnection> clientConnection_;
+    };
+
+    // Runs tasks right away, counting them
+    class CountingExecutor : public sdbus::IExecutor
+    {
+    public:
+        void execute(std::function<void()> task) override
+        {
+            ++executedTasks;
+            task();
+        }
+
+        std::atomic<int> executedTasks{};
+    };
+
+    sdbus::Task<int> incrementRemotely(sdbus::IObjectProxy& proxy, int value)
+    {
+        co_return co_await proxy.callMethodAsync("increment").onInterface("org.sdbuscpp.backend").withArguments(value).getResultAsAwaitable<int>();
+    }
+}
+
+/*-------------------------------------*/
+/* --          TEST CASES           -- */
+/*-------------------------------------*/
+
+TEST_F(DirectlyConnectedPeers, ResumesAwaitingCoroutineWithMethodResults)
+{
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/backend");
+    object->registerMethod("split").onInterface("org.sdbuscpp.backend").implementedAs([](int value){ return std::make_tuple(value / 2, std::to_string(value % 2)); });
+    object->finishRegistration();
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/backend");
+    proxy->finishRegistration();
+    startLoops();
+
+    std::promise<std::tuple<int, std::string>> promise;
+    // Captures would die with the lambda's temporary closure, parameters live in the coroutine frame
+    [](sdbus::IObjectProxy& proxy, std::promise<std::tuple<int, std::string>>& promise) -> FireAndForget
+    {
+        promise.set_value(co_await proxy.callMethodAsync("split").onInterface("org.sdbuscpp.backend").withArguments(7).getResultAsAwaitable<int, std::string>());
+    }(*proxy, promise);
+
+    auto future = promise.get_future();
+    ASSERT_THAT(future.wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+    ASSERT_THAT(future.get(), Eq(std::make_tuple(3, std::string("1"))));
+}
+
+TEST_F(DirectlyConnectedPeers, ResumesAwaitingCoroutineWithErrorFromMethod)
+{
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/backend");
+    object->registerMethod("fail").onInterface("org.sdbuscpp.backend").implementedAs([](){ throw sdbus::Error("org.sdbuscpp.Error", "Failed"); });
+    object->finishRegistration();
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/backend");
+    proxy->finishRegistration();
+    startLoops();
+
+    std::promise<std::string> promise;
+    [](sdbus::IObjectProxy& proxy, std::promise<std::string>& promise) -> FireAndForget
+    {
+        try
+        {
+            co_await proxy.callMethodAsync("fail").onInterface("org.sdbuscpp.backend").getResultAsAwaitable<>();
+        }
+        catch (const sdbus::Error& e)
+        {
+            promise.set_value(e.getName());
+        }
+    }(*proxy, promise);
+
+    auto future = promise.get_future();
+    ASSERT_THAT(future.wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+    ASSERT_THAT(future.get(), Eq("org.sdbuscpp.Error"));
+}
+
+TEST_F(DirectlyConnectedPeers, ResumesAwaitingCoroutineOnGivenExecutor)
+{
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/backend");
+    object->registerMethod("increment").onInterface("org.sdbuscpp.backend").implementedAs([](int value){ return value + 1; });
+    object->finishRegistration();
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/backend");
+    proxy->finishRegistration();
+    startLoops();
+    CountingExecutor executor;
+
+    std::promise<int> promise;
+    [](sdbus::IObjectProxy& proxy, CountingExecutor& executor, std::promise<int>& promise) -> FireAndForget
+    {
+        auto result = co_await proxy.callMethodAsync("increment").onInterface("org.sdbuscpp.backend").withArguments(1).getResultAsAwaitable<int>(executor);
+        promise.set_value(executor.executedTasks == 1 ? result : -1);
+    }(*proxy, executor, promise);
+
+    auto future = promise.get_future();
+    ASSERT_THAT(future.wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+    ASSERT_THAT(future.get(), Eq(2));
+}
+
+TEST_F(DirectlyConnectedPeers, ResumesAwaitingCoroutineWithErrorWhenCallIsCancelled)
+{
+    // The method never replies, its results are only dropped at the end of the test
+    std::vector<sdbus::Result<>> pendingResults;
+    std::promise<void> called;
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/backend");
+    object->registerMethod("hang").onInterface("org.sdbuscpp.backend").implementedAs([&](sdbus::Result<> result)
+    {
+        pendingResults.push_back(std::move(result));
+        called.set_value();
+    });
+    object->finishRegistration();
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/backend");
+    proxy->finishRegistration();
+    startLoops();
+
+    std::promise<std::string> promise;
+    [](sdbus::IObjectProxy& proxy, std::promise<std::string>& promise) -> FireAndForget
+    {
+        try
+        {
+            co_await proxy.callMethodAsync("hang").onInterface("org.sdbuscpp.backend").getResultAsAwaitable<>();
+            promise.set_value("");
+        }
+        catch (const sdbus::Error& e)
+        {
+            promise.set_value(e.getName());
+        }
+    }(*proxy, promise);
+    ASSERT_THAT(called.get_future().wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+
+    proxy.reset();
+
+    auto future = promise.get_future();
+    ASSERT_THAT(future.wait_for(std::chrono::seconds(1)), Eq(std::future_status::ready));
+    ASSERT_THAT(future.get(), Eq(sdbus::createError(ECANCELED, "").getName()));
+}
+
+TEST_F(DirectlyConnectedPeers, KeepsReferenceParametersOfCoroutineMethodAliveAcrossAwaits)
+{
+    // The server consults a backend, reachable over another pair of connections
+    int fds[2];
+    ASSERT_THAT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds), Eq(0));
+    auto backendConnection = sdbus::createServerConnection(fds[0]);
+    auto serverToBackendConnection = sdbus::createDirectConnection(fds[1]);
+    auto backend = sdbus::createObject(*backendConnection, "/org/sdbuscpp/backend");
+    backend->registerMethod("increment").onInterface("org.sdbuscpp.backend").implementedAs([](int value){ return value + 1; });
+    backend->finishRegistration();
+    backendConnection->enterProcessingLoopAsync();
+    auto backendProxy = sdbus::createObjectProxy(*serverToBackendConnection, "", "/org/sdbuscpp/backend");
+    backendProxy->finishRegistration();
+    serverToBackendConnection->enterProcessingLoopAsync();
+
+    // The reference parameter is in use both before and after the coroutine suspends
+    auto object = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/labeler");
+    object->registerMethod("label").onInterface("org.sdbuscpp.labeler").implementedAs([&](const std::string& name) -> sdbus::Task<std::string>
+    {
+        auto prefix = name.substr(0, 1);
+        auto number = co_await incrementRemotely(*backendProxy, 41);
+        co_return prefix + ":" + name + ":" + std::to_string(number);
+    });
+    object->finishRegistration();
+    auto proxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/labeler");
+    proxy->finishRegistration();
+    startLoops();
+
+    std::string result;
+    proxy->callMethod("label").onInterface("org.sdbuscpp.labeler").withArguments(std::string(64, 'x')).storeResultsTo(result);
+    ASSERT_THAT(result, Eq("x:" + std::string(64, 'x') + ":42"));
+
+    serverToBackendConnection->leaveProcessingLoop();
+    backendConnection->leaveProcessingLoop();
+}
+
+TEST_F(DirectlyConnectedPeers, RepliesFromCoroutineMethodThatAwaitsAnotherService)
+{
+    // The server is a gateway that consults a backend, reachable over another pair of connections
+    int fds[2];
+    ASSERT_THAT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds), Eq(0));
+    auto backendConnection = sdbus::createServerConnection(fds[0]);
+    auto gatewayToBackendConnection = sdbus::createDirectConnection(fds[1]);
+    auto backend = sdbus::createObject(*backendConnection, "/org/sdbuscpp/backend");
+    backend->registerMethod("increment").onInterface("org.sdbuscpp.backend").implementedAs([](int value){ return value + 1; });
+    backend->finishRegistration();
+    backendConnection->enterProcessingLoopAsync();
+    auto backendProxy = sdbus::createObjectProxy(*gatewayToBackendConnection, "", "/org/sdbuscpp/backend");
+    backendProxy->finishRegistration();
+    gatewayToBackendConnection->enterProcessingLoopAsync();
+
+    auto gateway = sdbus::createObject(*serverConnection_, "/org/sdbuscpp/gateway");
+    gateway->registerMethod("incrementTwice").onInterface("org.sdbuscpp.gateway").implementedAs([&](int value) -> sdbus::Task<int>
+    {
+        auto once = co_await incrementRemotely(*backendProxy, value);
+        co_return co_await incrementRemotely(*backendProxy, once);
+    });
+    gateway->registerMethod("failRemotely").onInterface("org.sdbuscpp.gateway").implementedAs([&]() -> sdbus::Task<>
+    {
+        co_await incrementRemotely(*backendProxy, 0);
+        throw sdbus::Error("org.sdbuscpp.Error", "Failed");
+    });
+    gateway->registerMethod("crashRemotely").onInterface("org.sdbuscpp.gateway").implementedAs([&]() -> sdbus::Task<>
+    {
+        co_await incrementRemotely(*backendProxy, 0);
+        throw std::runtime_error("Crashed");
+    });
+    gateway->finishRegistration();
+    auto gatewayProxy = sdbus::createObjectProxy(*clientConnection_, "", "/org/sdbuscpp/gateway");
+    gatewayProxy->finishRegistration();
+    startLoops();
+
+    int result{};
+    gatewayProxy->callMethod("incrementTwice").onInterface("org.sdbuscpp.gateway").withArguments(40).storeResultsTo(result);
+    ASSERT_THAT(result, Eq(42));
+    ASSERT_THROW(gatewayProxy->callMethod("failRemotely").onInterface("org.sdbuscpp.gateway"), sdbus::Error);
+    try
+    {
+        gatewayProxy->callMethod("crashRemotely").onInterface("org.sdbuscpp.gateway");
+        FAIL() << "Expected an error reply";
+    }
+    catch (const sdbus::Error& e)
+    {
+        ASSERT_THAT(e.getName(), Eq("org.freedesktop.DBus.Error.Failed"));
+    }
+
+    gatewayToBackendConnection->leaveProcessingLoop();
+    backendConnection->leaveProcessingLoop();
+}
+
+#endif /* SDBUS_HAS_COROUTINES */
@@ -30,6 +30,8 @@
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 class TestingAdaptor : public sdbus::Interfaces<testing_adaptor>
 {
@@ -37,7 +39,12 @@ public:
     TestingAdaptor(sdbus::IConnection& connection) :
         sdbus::Interfaces<::testing_adaptor>(connection, OBJECT_PATH) { }
 
-    virtual ~TestingAdaptor() { }
+    virtual ~TestingAdaptor()
+    {
+        // The object must outlive the replies of its async methods
+        for (auto& thread : m_asyncReplyThreads)
+            thread.join();
+    }
 
     bool wasMultiplyCalled() const { return m_multiplyCalled; }
     double getMultiplyResult() const { return m_multiplyResult; }
@@ -126,11 +133,12 @@ protected:
         else
         {
             // Process asynchronously in another thread and return the result from there
-            std::thread([param, result = std::move(result)]()
+            std::lock_guard<std::mutex> lock(m_asyncReplyThreadsMutex);
+            m_asyncReplyThreads.emplace_back([param, result = std::move(result)]()
             {
                 std::this_thread::sleep_for(std::chrono::milliseconds(param));
                 result.returnResults(param);
-            }).detach();
+            });
         }
     }
 
@@ -185,6 +193,9 @@ private:
     mutable std::atomic<bool> m_multiplyCalled{};
     mutable double m_multiplyResult{};
     mutable std::atomic<bool> m_throwErrorCalled{};
+
+    std::vector<std::thread> m_asyncReplyThreads;
+    std::mutex m_asyncReplyThreadsMutex;
 };
 
 
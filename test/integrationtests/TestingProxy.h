@@ -38,6 +38,9 @@ public:
     double getVariantValue() const { return m_variantValue; }
     std::map<std::string, std::string> getSignatureFromSignal() const { return m_signature; }
 
+    void enableSimpleSignal() { getProxy().enableSignalHandler(INTERFACE_NAME, "simpleSignal"); }
+    void disableSimpleSignal() { getProxy().disableSignalHandler(INTERFACE_NAME, "simpleSignal"); }
+
     void installDoOperationClientSideAsyncReplyHandler(std::function<void(uint32_t res, const sdbus::Error* err)> handler)
     {
         m_DoOperationClientSideAsyncReplyHandler = handler;
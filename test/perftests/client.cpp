@@ -33,14 +33,15 @@
 #include <chrono>
 #include <cassert>
 #include <algorithm>
+#include <cstring>
 
 using namespace std::chrono_literals;
 
 class PerftestClient : public sdbus::ProxyInterfaces<org::sdbuscpp::perftest_proxy>
 {
 public:
-    PerftestClient(std::string destination, std::string objectPath)
-        : sdbus::ProxyInterfaces<org::sdbuscpp::perftest_proxy>(std::move(destination), std::move(objectPath))
+    PerftestClient(std::unique_ptr<sdbus::IConnection>&& connection, std::string destination, std::string objectPath)
+        : sdbus::ProxyInterfaces<org::sdbuscpp::perftest_proxy>(std::move(connection), std::move(destination), std::move(objectPath))
     {
     }
 
@@ -86,12 +87,30 @@ std::string createRandomString(size_t length)
 }
 
 
+sdbus::IConnection::EventLoopBackend parseEventLoopBackend(int argc, char *argv[])
+{
+    if (argc > 1 && std::strcmp(argv[1], "io_uring") == 0)
+        return sdbus::IConnection::EventLoopBackend::eIoUring;
+    return sdbus::IConnection::EventLoopBackend::ePoll;
+}
+
+const char* toString(sdbus::IConnection::EventLoopBackend backend)
+{
+    return backend == sdbus::IConnection::EventLoopBackend::eIoUring ? "io_uring" : "poll";
+}
+
+
 //-----------------------------------------
-int main(int /*argc*/, char */*argv*/[])
+// Usage: libsdbus-c++_perftests_client [poll|io_uring]
+int main(int argc, char *argv[])
 {
+    auto connection = sdbus::createSystemBusConnection();
+    connection->setEventLoopBackend(parseEventLoopBackend(argc, argv));
+    std::cout << "** Client event loop backend: " << toString(connection->getEventLoopBackend()) << std::endl << std::endl;
+
     const char* destinationName = "org.sdbuscpp.perftest";
     const char* objectPath = "/org/sdbuscpp/perftest";
-    PerftestClient client(destinationName, objectPath);
+    PerftestClient client(std::move(connection), destinationName, objectPath);
 
     const unsigned int repetitions{20};
     unsigned int msgCount = 1000;
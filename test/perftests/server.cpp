@@ -30,6 +30,8 @@
 #include <thread>
 #include <chrono>
 #include <algorithm>
+#include <iostream>
+#include <cstring>
 
 using namespace std::chrono_literals;
 
@@ -40,6 +42,7 @@ class PerftestServer : public sdbus::Interfaces<org::sdbuscpp::perftest_adaptor>
 public:
     PerftestServer(sdbus::IConnection& connection, std::string objectPath)
         : sdbus::Interfaces<org::sdbuscpp::perftest_adaptor>(connection, std::move(objectPath))
+        , connection_(connection)
     {
     }
 
@@ -50,10 +53,14 @@ protected:
         char digits[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
         
         auto start_time = std::chrono::steady_clock::now();
-        for (uint32_t i = 0; i < numberOfSignals; ++i)
         {
-            // Emit signal
-            dataSignal(data);
+            // The burst is sent in one go when the cork is released
+            sdbus::ScopedCork<sdbus::IConnection> cork(connection_);
+            for (uint32_t i = 0; i < numberOfSignals; ++i)
+            {
+                // Emit signal
+                dataSignal(data);
+            }
         }
         auto stop_time = std::chrono::steady_clock::now();
         std::cout << "Server sent " << numberOfSignals << " signals in: " << std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time).count() << " ms" << std::endl;
@@ -63,6 +70,9 @@ protected:
     {
         return string1 + string2;
     }
+
+private:
+    sdbus::IConnection& connection_;
 };
 
 std::string createRandomString(size_t length)
@@ -82,11 +92,23 @@ std::string createRandomString(size_t length)
 }
 
 
+sdbus::IConnection::EventLoopBackend parseEventLoopBackend(int argc, char *argv[])
+{
+    if (argc > 1 && std::strcmp(argv[1], "io_uring") == 0)
+        return sdbus::IConnection::EventLoopBackend::eIoUring;
+    return sdbus::IConnection::EventLoopBackend::ePoll;
+}
+
+
 //-----------------------------------------
-int main(int /*argc*/, char */*argv*/[])
+// Usage: libsdbus-c++_perftests_server [poll|io_uring]
+int main(int argc, char *argv[])
 {
     const char* serviceName = "org.sdbuscpp.perftest";
     auto connection = sdbus::createSystemBusConnection(serviceName);
+    connection->setEventLoopBackend(parseEventLoopBackend(argc, argv));
+    std::cout << "Server event loop backend: "
+              << (connection->getEventLoopBackend() == sdbus::IConnection::EventLoopBackend::eIoUring ? "io_uring" : "poll") << std::endl;
 
     const char* objectPath = "/org/sdbuscpp/perftest";
     PerftestServer server(*connection, objectPath);
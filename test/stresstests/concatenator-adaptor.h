@@ -20,10 +20,14 @@ public:
     static constexpr const char* interfaceName = "org.sdbuscpp.stresstest.concatenator";
 
 protected:
-    concatenator_adaptor(sdbus::IObject& object)
+    concatenator_adaptor(sdbus::IObject& object, sdbus::IExecutor* executor = nullptr)
         : object_(object)
     {
         object_.registerMethod("concatenate").onInterface(interfaceName).implementedAs([this](sdbus::Result<std::string>&& result, std::map<std::string, sdbus::Variant> params){ this->concatenate(std::move(result), std::move(params)); });
+        if (executor != nullptr)
+        {
+            object_.setMethodExecutor(interfaceName, "concatenate", *executor);
+        }
         object_.registerSignal("concatenatedSignal").onInterface(interfaceName).withParameters<std::string>();
     }
 
@@ -39,9 +39,7 @@
 #include <cassert>
 #include <atomic>
 #include <sstream>
-#include <mutex>
-#include <condition_variable>
-#include <queue>
+#include <algorithm>
 
 using namespace std::chrono_literals;
 using namespace std::string_literals;
@@ -102,69 +100,23 @@ public:
 class ConcatenatorAdaptor : public sdbus::Interfaces<org::sdbuscpp::stresstest::concatenator_adaptor>
 {
 public:
-    ConcatenatorAdaptor(sdbus::IConnection& connection, std::string objectPath)
-        : sdbus::Interfaces<org::sdbuscpp::stresstest::concatenator_adaptor>(connection, std::move(objectPath))
+    ConcatenatorAdaptor(sdbus::IConnection& connection, std::string objectPath, sdbus::IExecutor& executor)
+        : sdbus::Interfaces<org::sdbuscpp::stresstest::concatenator_adaptor>(connection, std::move(objectPath), executor)
     {
-        unsigned int workers = std::thread::hardware_concurrency();
-        if (workers < 4)
-            workers = 4;
-
-        for (unsigned int i = 0; i < workers; ++i)
-            workers_.emplace_back([this]()
-            {
-                //std::cout << "Created worker thread 0x" << std::hex << std::this_thread::get_id() << std::dec << std::endl;
-
-                while(!exit_)
-                {
-                    // Pop a work item from the queue
-                    std::unique_lock<std::mutex> lock(mutex_);
-                    cond_.wait(lock, [this]{return !requests_.empty() || exit_;});
-                    if (exit_)
-                        break;
-                    auto request = std::move(requests_.front());
-                    requests_.pop();
-                    lock.unlock();
-
-                    // Do concatenation work, return results and fire signal
-                    auto aString = request.input.at("key1").get<std::string>();
-                    auto aNumber = request.input.at("key2").get<uint32_t>();
-                    auto resultString = aString + " " + std::to_string(aNumber);
-
-                    request.result.returnResults(resultString);
-
-                    concatenatedSignal(resultString);
-                }
-            });
-    }
-
-    ~ConcatenatorAdaptor()
-    {
-        exit_ = true;
-        cond_.notify_all();
-        for (auto& worker : workers_)
-            worker.join();
     }
 
 protected:
     virtual void concatenate(sdbus::Result<std::string>&& result, std::map<std::string, sdbus::Variant> params) override
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        requests_.push(WorkItem{std::move(params), std::move(result)});
-        lock.unlock();
-        cond_.notify_one();
-    }
+        // We run in an executor thread here, so we can do concatenation work, return results and fire signal right away
+        auto aString = params.at("key1").get<std::string>();
+        auto aNumber = params.at("key2").get<uint32_t>();
+        auto resultString = aString + " " + std::to_string(aNumber);
 
-private:
-    struct WorkItem
-    {
-        std::map<std::string, sdbus::Variant> input;
-        sdbus::Result<std::string> result;
-    };
-    std::mutex mutex_;
-    std::condition_variable cond_;
-    std::queue<WorkItem> requests_;
-    std::vector<std::thread> workers_;
-    std::atomic<bool> exit_{};
+        result.returnResults(resultString);
+
+        concatenatedSignal(resultString);
+    }
 };
 
 class ConcatenatorProxy : public sdbus::ProxyInterfaces<org::sdbuscpp::stresstest::concatenator_proxy>
@@ -221,7 +173,9 @@ int main(int /*argc*/, char */*argv*/[])
     auto service1Connection = sdbus::createSystemBusConnection(SERVICE_1_BUS_NAME);
     std::thread service1Thread([&con = *service1Connection]()
     {
-        ConcatenatorAdaptor concatenator(con, CONCATENATOR_OBJECT_PATH);
+        // The pool outlives the adaptor, whose destruction waits for its calls still queued in the pool
+        auto pool = sdbus::createThreadPool(std::max(std::thread::hardware_concurrency(), 4u));
+        ConcatenatorAdaptor concatenator(con, CONCATENATOR_OBJECT_PATH, *pool);
         FahrenheitThermometerAdaptor thermometer(con, FAHRENHEIT_THERMOMETER_OBJECT_PATH);
         con.enterProcessingLoop();
     });
@@ -26,14 +26,22 @@
 
 #include "Connection.h"
 #include "unittests/mocks/SdBusMock.h"
+#include <sdbus-c++/SignalFilter.h>
 
 #include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <poll.h>
+#include <future>
+#include <vector>
+#include <memory>
 
 using ::testing::_;
 using ::testing::DoAll;
 using ::testing::SetArgPointee;
+using ::testing::SaveArg;
 using ::testing::Return;
 using ::testing::NiceMock;
+using ::testing::Eq;
 
 using BusType = sdbus::internal::Connection::BusType;
 
@@ -104,6 +112,363 @@ TEST_F(ASessionBusConnection, ThrowsErrorWhenFlushingTheBusFailsDuringConstructi
     ASSERT_THROW(sdbus::internal::Connection(BusType::eSession, std::move(mock_)), sdbus::Error);
 }
 
+using ADirectConnection = ConnectionCreationTest;
+using AServerConnection = ConnectionCreationTest;
+
+TEST_F(ADirectConnection, OpensBusAtGivenAddressWithoutWaitingForHandshake)
+{
+    EXPECT_CALL(*mock_, sd_bus_open_direct(_, ::testing::Matcher<const char*>(::testing::StrEq("unix:path=/tmp/sdbus-c++.socket")))).WillOnce(DoAll(SetArgPointee<0>(STUB_), Return(0)));
+    EXPECT_CALL(*mock_, sd_bus_flush(_)).Times(0);
+    sdbus::internal::Connection(BusType::eDirect, std::move(mock_), std::string{"unix:path=/tmp/sdbus-c++.socket"});
+}
+
+TEST_F(ADirectConnection, OpensBusOverGivenSocketWithoutWaitingForHandshake)
+{
+    EXPECT_CALL(*mock_, sd_bus_open_direct(_, ::testing::Matcher<int>(7))).WillOnce(DoAll(SetArgPointee<0>(STUB_), Return(0)));
+    EXPECT_CALL(*mock_, sd_bus_flush(_)).Times(0);
+    sdbus::internal::Connection(BusType::eDirect, std::move(mock_), 7);
+}
+
+TEST_F(AServerConnection, OpensServerBusOverGivenSocketWithoutWaitingForHandshake)
+{
+    EXPECT_CALL(*mock_, sd_bus_open_server(_, 7)).WillOnce(DoAll(SetArgPointee<0>(STUB_), Return(0)));
+    EXPECT_CALL(*mock_, sd_bus_flush(_)).Times(0);
+    sdbus::internal::Connection(BusType::eServer, std::move(mock_), 7);
+}
+
+TEST_F(ADirectConnection, ThrowsErrorWhenOpeningTheBusFailsDuringConstruction)
+{
+    ON_CALL(*mock_, sd_bus_open_direct(_, ::testing::An<int>())).WillByDefault(Return(-ECONNREFUSED));
+    ASSERT_THROW(sdbus::internal::Connection(BusType::eDirect, std::move(mock_), 7), sdbus::Error);
+}
+
+TEST_F(ASystemBusConnection, SetsMethodCallTimeoutOnTheBus)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    EXPECT_CALL(*mock_, sd_bus_set_method_call_timeout(STUB_, 5000000)).WillOnce(Return(0));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    connection.setMethodCallTimeout(5000000);
+}
+
+TEST_F(ASystemBusConnection, InstallsSendHookWhenOutboundQueueIsEnabled)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::ISdBus::sd_bus_send_hook_t hook{};
+    void* userData{};
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(::testing::NotNull(), _)).WillOnce(DoAll(SaveArg<0>(&hook), SaveArg<1>(&userData)));
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(nullptr, _)).Times(1); // Upon destruction
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    connection.enableOutboundQueue();
+
+    // Without a running processing loop, messages are to be sent right away
+    ASSERT_THAT(hook(reinterpret_cast<sd_bus_message*>(1), userData), Eq(0));
+}
+
+TEST_F(ASystemBusConnection, HoldsBackMessagesSentWhileCorkedAndSendsThemUponUncork)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::ISdBus::sd_bus_send_hook_t hook{};
+    void* userData{};
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(::testing::NotNull(), _)).WillOnce(DoAll(SaveArg<0>(&hook), SaveArg<1>(&userData)));
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(nullptr, _)).Times(1); // Upon destruction
+    auto* message1 = reinterpret_cast<sd_bus_message*>(1);
+    auto* message2 = reinterpret_cast<sd_bus_message*>(2);
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*mock_, sd_bus_message_ref(message1));
+    EXPECT_CALL(*mock_, sd_bus_message_ref(message2));
+    std::vector<sd_bus_message*> sent;
+    EXPECT_CALL(*mock_, sd_bus_send_batch(STUB_, _, 2)).WillOnce(::testing::Invoke([&](sd_bus*, sd_bus_message** messages, size_t count)
+    {
+        sent.assign(messages, messages + count);
+        return 0;
+    }));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    connection.cork();
+    connection.cork();
+    ASSERT_THAT(hook(message1, userData), Eq(1));
+    connection.uncork(); // Nested, holds messages back still
+    ASSERT_THAT(hook(message2, userData), Eq(1));
+    connection.uncork();
+
+    ASSERT_THAT(sent, ::testing::ElementsAre(message1, message2));
+}
+
+TEST_F(ASystemBusConnection, ReleasesMessagesHeldBackByCorkLeftUponDestruction)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::ISdBus::sd_bus_send_hook_t hook{};
+    void* userData{};
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(::testing::NotNull(), _)).WillOnce(DoAll(SaveArg<0>(&hook), SaveArg<1>(&userData)));
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(nullptr, _)).Times(1); // Upon destruction
+    auto* message = reinterpret_cast<sd_bus_message*>(1);
+    EXPECT_CALL(*mock_, sd_bus_message_ref(message));
+    EXPECT_CALL(*mock_, sd_bus_message_unref(message)).Times(1);
+    EXPECT_CALL(*mock_, sd_bus_send_batch(_, _, _)).Times(0);
+    auto connection = std::make_unique<sdbus::internal::Connection>(BusType::eSystem, std::move(mock_));
+
+    connection->cork();
+    ASSERT_THAT(hook(message, userData), Eq(1));
+    connection.reset();
+}
+
+TEST_F(ASystemBusConnection, CannotBeUncorkedWithoutBeingCorked)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    ASSERT_THROW(connection.uncork(), sdbus::Error);
+}
+
+TEST_F(ASystemBusConnection, CannotEnableOutboundQueueTwice)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    connection.enableOutboundQueue();
+
+    ASSERT_THROW(connection.enableOutboundQueue(), sdbus::Error);
+}
+
+TEST_F(ASystemBusConnection, RefusesMessagesWhenWriteQueueLimitIsReachedUnderFailFastPolicy)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::ISdBus::sd_bus_send_hook_t hook{};
+    void* userData{};
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(::testing::NotNull(), _)).WillOnce(DoAll(SaveArg<0>(&hook), SaveArg<1>(&userData)));
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(nullptr, _)).Times(1); // Upon destruction
+    EXPECT_CALL(*mock_, sd_bus_get_n_queued_write(STUB_, _)).WillOnce(DoAll(SetArgPointee<1>(3), Return(0)))
+                                                               .WillOnce(DoAll(SetArgPointee<1>(4), Return(0)));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    connection.setWriteQueueLimit(4, sdbus::IConnection::OverflowPolicy::eFailFast);
+
+    auto* message = reinterpret_cast<sd_bus_message*>(1);
+    ASSERT_THAT(hook(message, userData), Eq(0));
+    ASSERT_THAT(hook(message, userData), Eq(-ENOBUFS));
+}
+
+TEST_F(ASystemBusConnection, DropsMessagesWithoutReferencingThemWhenWriteQueueLimitIsReachedUnderDropNewestPolicy)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::ISdBus::sd_bus_send_hook_t hook{};
+    void* userData{};
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(::testing::NotNull(), _)).WillOnce(DoAll(SaveArg<0>(&hook), SaveArg<1>(&userData)));
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(nullptr, _)).Times(1); // Upon destruction
+    EXPECT_CALL(*mock_, sd_bus_get_n_queued_write(STUB_, _)).WillOnce(DoAll(SetArgPointee<1>(5), Return(0)));
+    EXPECT_CALL(*mock_, sd_bus_message_ref(_)).Times(0);
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    connection.setWriteQueueLimit(4, sdbus::IConnection::OverflowPolicy::eDropNewest);
+
+    ASSERT_THAT(hook(reinterpret_cast<sd_bus_message*>(1), userData), Eq(1));
+}
+
+TEST_F(ASystemBusConnection, NotifiesWhenWriteQueueDepthCrossesHighWatermark)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::ISdBus::sd_bus_send_hook_t hook{};
+    void* userData{};
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(::testing::NotNull(), _)).WillOnce(DoAll(SaveArg<0>(&hook), SaveArg<1>(&userData)));
+    EXPECT_CALL(*mock_, sd_bus_set_send_hook(nullptr, _)).Times(1); // Upon destruction
+    EXPECT_CALL(*mock_, sd_bus_get_n_queued_write(STUB_, _)).WillOnce(DoAll(SetArgPointee<1>(9), Return(0)))
+                                                               .WillRepeatedly(DoAll(SetArgPointee<1>(10), Return(0)));
+    std::vector<bool> notifications;
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    connection.setWriteQueueWatermarks(2, 10, [&](bool congested){ notifications.push_back(congested); });
+
+    auto* message = reinterpret_cast<sd_bus_message*>(1);
+    hook(message, userData);
+    hook(message, userData);
+    hook(message, userData); // Still congested, no repeated notification
+
+    ASSERT_THAT(notifications, ::testing::ElementsAre(true));
+}
+
+TEST_F(ASystemBusConnection, RejectsWriteQueueWatermarksWithLowAboveHigh)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    ASSERT_THROW(connection.setWriteQueueWatermarks(10, 2, [](bool){}), sdbus::Error);
+}
+
+TEST_F(ASystemBusConnection, ReportsWriteQueueDepthFromUnderlyingBus)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    EXPECT_CALL(*mock_, sd_bus_get_n_queued_write(STUB_, _)).WillOnce(DoAll(SetArgPointee<1>(7), Return(0)));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    ASSERT_THAT(connection.getWriteQueueDepth(), Eq(7u));
+}
+
+TEST_F(ASystemBusConnection, RequestsNameAlongWithHandshakeWhenCreatedWithName)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    EXPECT_CALL(*mock_, sd_bus_request_name_async(STUB_, _, ::testing::StrEq("org.sdbuscpp.name"), 0, ::testing::NotNull(), _)).WillOnce(Return(-EACCES));
+    EXPECT_CALL(*mock_, sd_bus_flush(_)).Times(0);
+
+    ASSERT_THROW(sdbus::internal::Connection(BusType::eSystem, std::move(mock_), "org.sdbuscpp.name", sdbus::internal::Connection::request_name), sdbus::Error);
+}
+
+TEST_F(ASystemBusConnection, FallsBackToSynchronousNameRequestWhenAsyncOneIsNotSupported)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*mock_, sd_bus_request_name_async(STUB_, _, _, _, _, _)).WillOnce(Return(-EOPNOTSUPP));
+    EXPECT_CALL(*mock_, sd_bus_flush(STUB_)).WillOnce(Return(1));
+    EXPECT_CALL(*mock_, sd_bus_request_name(STUB_, ::testing::StrEq("org.sdbuscpp.name"), 0)).WillOnce(Return(1));
+
+    ASSERT_NO_THROW(sdbus::internal::Connection(BusType::eSystem, std::move(mock_), "org.sdbuscpp.name", sdbus::internal::Connection::request_name));
+}
+
+TEST_F(ASystemBusConnection, AddsSignalMatchAsynchronouslyWhenProcessingLoopRuns)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::ISdBus::PollData idlePollData{-1, 0, UINT64_MAX};
+    ON_CALL(*mock_, sd_bus_process_batch(_, _, _, _, _)).WillByDefault(DoAll(SetArgPointee<4>(idlePollData), Return(0)));
+    EXPECT_CALL(*mock_, sd_bus_add_match(_, _, _, _, _)).Times(0);
+    EXPECT_CALL(*mock_, sd_bus_add_match_async(STUB_, _, _, ::testing::NotNull(), ::testing::NotNull(), _)).WillOnce(Return(1));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+    std::promise<void> running;
+    connection.setDrainReportHandler([&running, once = true](std::size_t) mutable { if (once) running.set_value(); once = false; });
+    connection.enterProcessingLoopAsync();
+    running.get_future().wait();
+
+    auto callback = [](sd_bus_message*, void*, sd_bus_error*){ return 1; };
+    connection.registerSignalHandler("/org/sdbuscpp", "org.sdbuscpp.iface", "signal", sdbus::SignalFilter{}, callback, callback, nullptr);
+
+    connection.leaveProcessingLoop();
+}
+
+TEST_F(ASystemBusConnection, AddsSignalMatchAsynchronouslyWithoutProcessingLoop)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    EXPECT_CALL(*mock_, sd_bus_add_match(_, _, _, _, _)).Times(0);
+    EXPECT_CALL(*mock_, sd_bus_add_match_async(STUB_, _, _, ::testing::NotNull(), ::testing::NotNull(), _)).WillOnce(Return(1));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    auto callback = [](sd_bus_message*, void*, sd_bus_error*){ return 1; };
+    connection.registerSignalHandler("/org/sdbuscpp", "org.sdbuscpp.iface", "signal", sdbus::SignalFilter{}, callback, callback, nullptr);
+}
+
+TEST_F(ASystemBusConnection, AddsSignalMatchSynchronouslyWithinMessageDispatch)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    ON_CALL(*mock_, sd_bus_get_current_message(STUB_)).WillByDefault(Return(reinterpret_cast<sd_bus_message*>(0x3e55)));
+    EXPECT_CALL(*mock_, sd_bus_add_match_async(_, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(*mock_, sd_bus_add_match(STUB_, _, _, ::testing::NotNull(), _)).WillOnce(Return(-EPERM));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+
+    auto callback = [](sd_bus_message*, void*, sd_bus_error*){ return 1; };
+    ASSERT_THROW(connection.registerSignalHandler("/org/sdbuscpp", "org.sdbuscpp.iface", "signal", sdbus::SignalFilter{}, callback, callback, nullptr), sdbus::Error);
+}
+
+TEST_F(ASystemBusConnection, SharesOneMatchRulePerInterfaceAmongDemultiplexedSignalHandlers)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    auto* slot = reinterpret_cast<sd_bus_slot*>(0x5107);
+    EXPECT_CALL(*mock_, sd_bus_add_match_async(STUB_, _, ::testing::StrEq("type='signal',interface='org.sdbuscpp.iface'"), _, _, _))
+        .WillOnce(DoAll(SetArgPointee<1>(slot), Return(1)));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+    connection.enableSignalDemultiplexing();
+
+    auto callback = [](sd_bus_message*, void*, sd_bus_error*){ return 1; };
+    auto first = connection.registerSignalHandler("/org/sdbuscpp/1", "org.sdbuscpp.iface", "signal", sdbus::SignalFilter{}, callback, callback, nullptr);
+    auto second = connection.registerSignalHandler("/org/sdbuscpp/2", "org.sdbuscpp.iface", "signal", sdbus::SignalFilter{}, callback, callback, nullptr);
+
+    auto& sdbus = dynamic_cast<SdBusMock&>(connection.getSdBusInterface());
+    EXPECT_CALL(sdbus, sd_bus_slot_unref(slot)).Times(0);
+    first.reset();
+    ::testing::Mock::VerifyAndClearExpectations(&sdbus);
+    EXPECT_CALL(sdbus, sd_bus_slot_unref(slot)).Times(1);
+    second.reset();
+}
+
+TEST_F(ASystemBusConnection, LetsSubscriberComingWhileSharedMatchRuleIsBeingRemovedAddItAnew)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    auto* oldSlot = reinterpret_cast<sd_bus_slot*>(0x5107);
+    auto* newSlot = reinterpret_cast<sd_bus_slot*>(0x5108);
+    EXPECT_CALL(*mock_, sd_bus_add_match_async(STUB_, _, _, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<1>(oldSlot), Return(1)))
+        .WillOnce(DoAll(SetArgPointee<1>(newSlot), Return(1)));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+    connection.enableSignalDemultiplexing();
+    auto callback = [](sd_bus_message*, void*, sd_bus_error*){ return 1; };
+    auto first = connection.registerSignalHandler("/org/sdbuscpp/1", "org.sdbuscpp.iface", "signal", sdbus::SignalFilter{}, callback, callback, nullptr);
+
+    auto& sdbus = dynamic_cast<SdBusMock&>(connection.getSdBusInterface());
+    sdbus::internal::SignalSlot second;
+    EXPECT_CALL(sdbus, sd_bus_slot_unref(oldSlot)).WillOnce(::testing::Invoke([&](sd_bus_slot*)
+    {
+        second = connection.registerSignalHandler("/org/sdbuscpp/2", "org.sdbuscpp.iface", "signal", sdbus::SignalFilter{}, callback, callback, nullptr);
+        return nullptr;
+    }));
+    first.reset();
+    ::testing::Mock::VerifyAndClearExpectations(&sdbus);
+
+    EXPECT_CALL(sdbus, sd_bus_slot_unref(newSlot)).Times(1);
+    second.reset();
+}
+
+TEST_F(ASystemBusConnection, HandsSharedMatchInstallReplyOnlyToSubscribersWaitingForIt)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sd_bus_message_handler_t installed{};
+    void* matchData{};
+    EXPECT_CALL(*mock_, sd_bus_add_match_async(STUB_, _, _, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<1>(reinterpret_cast<sd_bus_slot*>(0x5107)), SaveArg<4>(&installed), SaveArg<5>(&matchData), Return(1)));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+    connection.enableSignalDemultiplexing();
+    auto callback = [](sd_bus_message*, void* userData, sd_bus_error*){ ++*static_cast<int*>(userData); return 1; };
+    int first{}, second{}, third{};
+    auto firstSlot = connection.registerSignalHandler("/org/sdbuscpp/1", "org.sdbuscpp.iface", "signal", sdbus::SignalFilter{}, callback, callback, &first);
+    auto secondSlot = connection.registerSignalHandler("/org/sdbuscpp/2", "org.sdbuscpp.iface", "signal", sdbus::SignalFilter{}, callback, callback, &second);
+
+    installed(nullptr, matchData, nullptr);
+    auto thirdSlot = connection.registerSignalHandler("/org/sdbuscpp/3", "org.sdbuscpp.iface", "signal", sdbus::SignalFilter{}, callback, callback, &third);
+    installed(nullptr, matchData, nullptr);
+
+    ASSERT_THAT(first, Eq(1));
+    ASSERT_THAT(second, Eq(1));
+    ASSERT_THAT(third, Eq(0));
+}
+
+TEST_F(ASystemBusConnection, PutsSignalFilterPredicatesIntoMatchRule)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    std::string match;
+    EXPECT_CALL(*mock_, sd_bus_add_match_async(STUB_, _, _, _, _, _)).WillOnce(DoAll(::testing::Invoke([&](sd_bus*, sd_bus_slot**, const char* rule, auto, auto, void*){ match = rule; }), Return(1)));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+    sdbus::SignalFilter filter;
+    filter.setArgument(0, "it's");
+    filter.setArgument(2, "dev7");
+    filter.setArgumentPath(1, "/org/sdbuscpp/");
+    filter.setArgument0Namespace("org.sdbuscpp");
+    filter.setPathNamespace();
+
+    auto callback = [](sd_bus_message*, void*, sd_bus_error*){ return 1; };
+    connection.registerSignalHandler("/org/sdbuscpp", "org.sdbuscpp.iface", "signal", filter, callback, callback, nullptr);
+
+    ASSERT_THAT(match, Eq( "type='signal',interface='org.sdbuscpp.iface',member='signal',path_namespace='/org/sdbuscpp'"
+                           ",arg0='it'\\''s',arg2='dev7',arg1path='/org/sdbuscpp/',arg0namespace='org.sdbuscpp'" ));
+}
+
+TEST_F(ASystemBusConnection, RejectsSignalFilterWithArgumentIndexOutOfRange)
+{
+    ON_CALL(*mock_, sd_bus_open_system(_)).WillByDefault(DoAll(SetArgPointee<0>(STUB_), Return(1)));
+    sdbus::internal::Connection connection(BusType::eSystem, std::move(mock_));
+    sdbus::SignalFilter filter;
+    filter.setArgument(64, "value");
+
+    auto callback = [](sd_bus_message*, void*, sd_bus_error*){ return 1; };
+    ASSERT_THROW(connection.registerSignalHandler("/", "org.sdbuscpp.iface", "signal", filter, callback, callback, nullptr), sdbus::Error);
+}
+
 class ConnectionRequestTest : public ::testing::TestWithParam<BusType>
 {
 protected:
@@ -146,3 +511,104 @@ TEST_P(AConnectionNameRequest, ThrowsOnFail)
 }
 
 INSTANTIATE_TEST_SUITE_P(Request, AConnectionNameRequest, ::testing::Values(BusType::eSystem, BusType::eSession));
+
+using AConnectionDrivenByExternalLoop = ConnectionRequestTest;
+
+TEST_P(AConnectionDrivenByExternalLoop, ProvidesPollDataOfTheUnderlyingBus)
+{
+    sdbus::internal::ISdBus::PollData pollData{7, POLLIN | POLLOUT, 123};
+    EXPECT_CALL(*mock_, sd_bus_get_poll_data(STUB_, _)).WillOnce(DoAll(SetArgPointee<1>(pollData), Return(1)));
+    sdbus::internal::Connection conn_(GetParam(), std::move(mock_));
+
+    auto result = conn_.getEventLoopPollData();
+
+    ASSERT_THAT(result.fd, Eq(7));
+    ASSERT_THAT(result.events, Eq(POLLIN | POLLOUT));
+    ASSERT_THAT(result.timeout_usec, Eq(123u));
+}
+
+TEST_P(AConnectionDrivenByExternalLoop, ThrowsWhenGettingPollDataFails)
+{
+    EXPECT_CALL(*mock_, sd_bus_get_poll_data(_, _)).WillOnce(Return(-1));
+    sdbus::internal::Connection conn_(GetParam(), std::move(mock_));
+
+    ASSERT_THROW(conn_.getEventLoopPollData(), sdbus::Error);
+}
+
+TEST_P(AConnectionDrivenByExternalLoop, ReportsWhetherAPendingRequestWasProcessed)
+{
+    EXPECT_CALL(*mock_, sd_bus_process(STUB_, _)).WillOnce(Return(1)).WillOnce(Return(0));
+    sdbus::internal::Connection conn_(GetParam(), std::move(mock_));
+
+    ASSERT_TRUE(conn_.processPendingRequest());
+    ASSERT_FALSE(conn_.processPendingRequest());
+}
+
+TEST_P(AConnectionDrivenByExternalLoop, ThrowsWhenProcessingFails)
+{
+    EXPECT_CALL(*mock_, sd_bus_process(_, _)).WillOnce(Return(-1));
+    sdbus::internal::Connection conn_(GetParam(), std::move(mock_));
+
+    ASSERT_THROW(conn_.processPendingRequest(), sdbus::Error);
+}
+
+INSTANTIATE_TEST_SUITE_P(ExternalLoop, AConnectionDrivenByExternalLoop, ::testing::Values(BusType::eSystem, BusType::eSession));
+
+using AConnectionProcessingLoop = ConnectionRequestTest;
+
+TEST_P(AConnectionProcessingLoop, DrainsMessagesInBatchesWithinTheBudgetAndReportsTheDrainedCount)
+{
+    sdbus::internal::ISdBus::PollData idlePollData{-1, 0, UINT64_MAX};
+    sdbus::internal::ISdBus::PollData busyPollData{-1, 0, 0};
+    EXPECT_CALL(*mock_, sd_bus_process_batch(STUB_, 5, 100, _, _))
+        .WillOnce(DoAll(SetArgPointee<3>(5), SetArgPointee<4>(busyPollData), Return(1)))
+        .WillOnce(DoAll(SetArgPointee<3>(2), SetArgPointee<4>(idlePollData), Return(0)));
+    sdbus::internal::Connection conn_(GetParam(), std::move(mock_));
+    conn_.setProcessingBudget(5, std::chrono::microseconds(100));
+    std::promise<std::size_t> drained;
+    conn_.setDrainReportHandler([&drained](std::size_t count){ drained.set_value(count); });
+
+    conn_.enterProcessingLoopAsync();
+    auto drainedCount = drained.get_future().get();
+    conn_.leaveProcessingLoop();
+
+    ASSERT_THAT(drainedCount, Eq(7u));
+}
+
+TEST_P(AConnectionProcessingLoop, LeavesBetweenBatchesEvenWhenMessagesKeepComing)
+{
+    sdbus::internal::ISdBus::PollData busyPollData{-1, 0, 0};
+    ON_CALL(*mock_, sd_bus_process_batch(_, _, _, _, _)).WillByDefault(DoAll(SetArgPointee<3>(1), SetArgPointee<4>(busyPollData), Return(1)));
+    sdbus::internal::Connection conn_(GetParam(), std::move(mock_));
+
+    conn_.enterProcessingLoopAsync();
+    conn_.leaveProcessingLoop();
+}
+
+TEST_P(AConnectionProcessingLoop, CannotChangeBudgetWhileRunning)
+{
+    sdbus::internal::ISdBus::PollData idlePollData{-1, 0, UINT64_MAX};
+    ON_CALL(*mock_, sd_bus_process_batch(_, _, _, _, _)).WillByDefault(DoAll(SetArgPointee<4>(idlePollData), Return(0)));
+    sdbus::internal::Connection conn_(GetParam(), std::move(mock_));
+    std::promise<void> running;
+    conn_.setDrainReportHandler([&running, once = true](std::size_t) mutable { if (once) running.set_value(); once = false; });
+
+    conn_.enterProcessingLoopAsync();
+    running.get_future().wait();
+
+    ASSERT_THROW(conn_.setProcessingBudget(10, std::chrono::microseconds{}), sdbus::Error);
+    conn_.leaveProcessingLoop();
+}
+
+INSTANTIATE_TEST_SUITE_P(ProcessingLoop, AConnectionProcessingLoop, ::testing::Values(BusType::eSystem, BusType::eSession));
+
+TEST(PollData, ConvertsAbsoluteTimeoutToRelativePollTimeout)
+{
+    using namespace std::chrono;
+    auto now = duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+
+    ASSERT_THAT((sdbus::IConnection::PollData{0, 0, UINT64_MAX}.getPollTimeout()), Eq(-1));
+    ASSERT_THAT((sdbus::IConnection::PollData{0, 0, 0}.getPollTimeout()), Eq(0));
+    auto timeout = sdbus::IConnection::PollData{0, 0, static_cast<uint64_t>(now) + 5000000}.getPollTimeout();
+    ASSERT_TRUE(timeout > 4000 && timeout <= 5000);
+}
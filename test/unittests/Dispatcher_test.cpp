@@ -0,0 +1,117 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file Dispatcher_test.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Dispatcher.h"
+#include <sdbus-c++/Error.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <future>
+#include <stdexcept>
+#include <sched.h>
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+using namespace std::chrono_literals;
+
+TEST(ADispatcher, CannotBeCreatedWithoutWorkers)
+{
+    ASSERT_THROW(sdbus::internal::Dispatcher(0), sdbus::Error);
+}
+
+TEST(ADispatcher, RunsTasksWithTheSameKeyInPostingOrder)
+{
+    std::vector<int> order;
+    {
+        sdbus::internal::Dispatcher dispatcher{4};
+        for (int i = 0; i < 100; ++i)
+            dispatcher.post(7, [&order, i](){ order.push_back(i); });
+    }
+
+    ASSERT_THAT(order.size(), Eq(100u));
+    for (int i = 0; i < 100; ++i)
+        ASSERT_THAT(order[i], Eq(i));
+}
+
+TEST(ADispatcher, RunsTasksWithDifferentKeysConcurrently)
+{
+    sdbus::internal::Dispatcher dispatcher{2};
+    std::promise<void> firstStarted;
+    std::promise<void> secondDone;
+
+    dispatcher.post(0, [&](){ firstStarted.set_value(); secondDone.get_future().wait(); });
+    firstStarted.get_future().wait();
+    dispatcher.post(1, [&](){ secondDone.set_value(); });
+}
+
+TEST(ADispatcher, FinishesPendingTasksWhenDestroyed)
+{
+    std::atomic<int> counter{};
+    {
+        sdbus::internal::Dispatcher dispatcher{3};
+        for (std::size_t i = 0; i < 30; ++i)
+            dispatcher.post(i, [&counter](){ std::this_thread::sleep_for(1ms); ++counter; });
+    }
+
+    ASSERT_THAT(counter, Eq(30));
+}
+
+TEST(ADispatcher, KeepsRunningTasksAfterATaskThrows)
+{
+    std::atomic<int> counter{};
+    {
+        sdbus::internal::Dispatcher dispatcher{1};
+        dispatcher.post(0, [](){ throw std::runtime_error("Task failed"); });
+        dispatcher.post(0, [&counter](){ ++counter; });
+    }
+
+    ASSERT_THAT(counter, Eq(1));
+}
+
+TEST(ADispatcher, RunsTasksOfPinnedWorkerOnItsCpu)
+{
+    cpu_set_t allowedCpus;
+    ASSERT_THAT(sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus), Eq(0));
+    unsigned cpu = 0;
+    while (!CPU_ISSET(cpu, &allowedCpus))
+        ++cpu;
+
+    std::promise<int> promise;
+    {
+        sdbus::internal::Dispatcher dispatcher{std::vector<unsigned>{cpu}};
+        dispatcher.post(0, [&promise](){ promise.set_value(sched_getcpu()); });
+    }
+
+    ASSERT_THAT(promise.get_future().get(), Eq(static_cast<int>(cpu)));
+}
+
+TEST(ADispatcher, CannotPinWorkerToNonexistentCpu)
+{
+    ASSERT_THROW(sdbus::internal::Dispatcher(std::vector<unsigned>{CPU_SETSIZE}), sdbus::Error);
+}
@@ -25,12 +25,16 @@
 
 #include <sdbus-c++/Types.h>
 #include "MessageUtils.h"
+#include "mocks/SdBusMock.h"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <cstdint>
 
 using ::testing::Eq;
 using ::testing::DoubleEq;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::_;
 using namespace std::string_literals;
 
 namespace
@@ -80,6 +84,23 @@ TEST(AMessage, CreatesShallowCopyWhenCopyConstructed)
     ASSERT_THROW(msgCopy >> str, sdbus::Error);
 }
 
+TEST(AMessage, TakesSingleUnderlyingReferenceForAllItsCopies)
+{
+    NiceMock<SdBusMock> sdbusMock;
+    auto* sdbusMsg = reinterpret_cast<sd_bus_message*>(1);
+    ON_CALL(sdbusMock, sd_bus_message_ref(_)).WillByDefault(Return(sdbusMsg));
+    EXPECT_CALL(sdbusMock, sd_bus_message_ref(sdbusMsg)).Times(1);
+    EXPECT_CALL(sdbusMock, sd_bus_message_unref(sdbusMsg)).Times(1);
+
+    {
+        sdbus::Message msg{sdbusMsg, &sdbusMock};
+        sdbus::Message msgCopy1 = msg;
+        sdbus::Message msgCopy2;
+        msgCopy2 = msgCopy1;
+        sdbus::Message msgMoved = std::move(msgCopy1);
+    }
+}
+
 TEST(AMessage, CreatesDeepCopyWhenEplicitlyCopied)
 {
     sdbus::Message msg{sdbus::createPlainMessage()};
@@ -172,6 +193,47 @@ TEST(AMessage, CanCarryAnArray)
     ASSERT_THAT(dataRead, Eq(dataWritten));
 }
 
+TEST(AMessage, CanCarryALargeArrayOfFixedSizeValuesInOneBlock)
+{
+    sdbus::Message msg{sdbus::createPlainMessage()};
+
+    std::vector<double> dataWritten(100000);
+    for (std::size_t i = 0; i < dataWritten.size(); ++i)
+        dataWritten[i] = i * 0.5;
+    std::vector<uint8_t> bytesWritten{0, 1, 254, 255};
+    std::vector<int16_t> emptyWritten;
+
+    msg << dataWritten << bytesWritten << emptyWritten;
+    msg.seal();
+
+    std::vector<double> dataRead;
+    std::vector<uint8_t> bytesRead;
+    std::vector<int16_t> emptyRead;
+    msg >> dataRead >> bytesRead >> emptyRead;
+
+    ASSERT_THAT(dataRead, Eq(dataWritten));
+    ASSERT_THAT(bytesRead, Eq(bytesWritten));
+    ASSERT_TRUE(emptyRead.empty());
+}
+
+TEST(AMessage, CanCarryNestedArraysOfFixedSizeValuesAndArraysOfBools)
+{
+    sdbus::Message msg{sdbus::createPlainMessage()};
+
+    std::vector<std::vector<int32_t>> nestedWritten{{1, 2, 3}, {}, {-4}};
+    std::vector<bool> boolsWritten{true, false, true};
+
+    msg << nestedWritten << boolsWritten;
+    msg.seal();
+
+    std::vector<std::vector<int32_t>> nestedRead;
+    std::vector<bool> boolsRead;
+    msg >> nestedRead >> boolsRead;
+
+    ASSERT_THAT(nestedRead, Eq(nestedWritten));
+    ASSERT_THAT(boolsRead, Eq(boolsWritten));
+}
+
 TEST(AMessage, CanCarryADictionary)
 {
     sdbus::Message msg{sdbus::createPlainMessage()};
@@ -0,0 +1,102 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file OutboundQueue_test.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OutboundQueue.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+#include <thread>
+#include <cstdint>
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+
+namespace
+{
+    sd_bus_message* fakeMessage(std::uintptr_t id)
+    {
+        return reinterpret_cast<sd_bus_message*>(id);
+    }
+}
+
+TEST(AnOutboundQueue, ReportsTheFirstPushIntoAnEmptyQueueOnly)
+{
+    sdbus::internal::OutboundQueue queue;
+
+    ASSERT_TRUE(queue.push(fakeMessage(1)));
+    ASSERT_FALSE(queue.push(fakeMessage(2)));
+
+    std::vector<sd_bus_message*> messages;
+    queue.popAll(messages);
+
+    ASSERT_TRUE(queue.push(fakeMessage(3)));
+    queue.popAll(messages);
+}
+
+TEST(AnOutboundQueue, GivesMessagesOutInPushingOrder)
+{
+    sdbus::internal::OutboundQueue queue;
+    queue.push(fakeMessage(1));
+    queue.push(fakeMessage(2));
+    queue.push(fakeMessage(3));
+
+    std::vector<sd_bus_message*> messages{fakeMessage(9)};
+    queue.popAll(messages);
+
+    ASSERT_THAT(messages, ElementsAre(fakeMessage(9), fakeMessage(1), fakeMessage(2), fakeMessage(3)));
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(AnOutboundQueue, KeepsMessagesOfEachProducerInOrderUnderConcurrentPushing)
+{
+    constexpr std::uintptr_t producerCount = 4;
+    constexpr std::uintptr_t messageCount = 10000;
+    sdbus::internal::OutboundQueue queue;
+
+    std::vector<std::thread> producers;
+    for (std::uintptr_t p = 0; p < producerCount; ++p)
+        producers.emplace_back([&queue, p]()
+        {
+            for (std::uintptr_t i = 1; i <= messageCount; ++i)
+                queue.push(fakeMessage(p << 32 | i));
+        });
+
+    std::vector<sd_bus_message*> messages;
+    while (messages.size() < producerCount * messageCount)
+        queue.popAll(messages);
+    for (auto& producer : producers)
+        producer.join();
+
+    std::vector<std::uintptr_t> lastSeen(producerCount);
+    for (auto* message : messages)
+    {
+        auto id = reinterpret_cast<std::uintptr_t>(message);
+        auto producer = id >> 32;
+        ASSERT_THAT(id & 0xFFFFFFFF, Eq(lastSeen[producer] + 1));
+        lastSeen[producer] = id & 0xFFFFFFFF;
+    }
+    ASSERT_TRUE(queue.empty());
+}
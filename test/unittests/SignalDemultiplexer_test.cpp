@@ -0,0 +1,111 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file SignalDemultiplexer_test.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "SignalDemultiplexer.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+#include <functional>
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+
+namespace
+{
+    struct Handler
+    {
+        std::vector<int>* calls;
+        int id;
+        std::function<void()> action;
+    };
+
+    int handle(sd_bus_message* /*message*/, void* userData, sd_bus_error* /*retError*/)
+    {
+        auto* handler = static_cast<Handler*>(userData);
+        handler->calls->push_back(handler->id);
+        if (handler->action)
+            handler->action();
+        return 1;
+    }
+}
+
+TEST(ASignalDemultiplexer, RoutesSignalToHandlerOfItsObjectInterfaceAndName)
+{
+    sdbus::internal::SignalDemultiplexer demux;
+    std::vector<int> calls;
+    Handler first{&calls, 1, {}}, second{&calls, 2, {}}, third{&calls, 3, {}};
+    demux.addRoute("/a", "org.test", "changed", &handle, &first);
+    demux.addRoute("/b", "org.test", "changed", &handle, &second);
+    demux.addRoute("/a", "org.test", "removed", &handle, &third);
+
+    auto dispatched = demux.dispatch("/b", "org.test", "changed", nullptr, nullptr);
+
+    ASSERT_THAT(dispatched, Eq(1u));
+    ASSERT_THAT(calls, ElementsAre(2));
+}
+
+TEST(ASignalDemultiplexer, RoutesSignalToAllHandlersOfTheSameSignal)
+{
+    sdbus::internal::SignalDemultiplexer demux;
+    std::vector<int> calls;
+    Handler first{&calls, 1, {}}, second{&calls, 2, {}};
+    demux.addRoute("/a", "org.test", "changed", &handle, &first);
+    demux.addRoute("/a", "org.test", "changed", &handle, &second);
+
+    auto dispatched = demux.dispatch("/a", "org.test", "changed", nullptr, nullptr);
+
+    ASSERT_THAT(dispatched, Eq(2u));
+    ASSERT_THAT(calls.size(), Eq(2u));
+}
+
+TEST(ASignalDemultiplexer, DropsSignalWithoutRoute)
+{
+    sdbus::internal::SignalDemultiplexer demux;
+    std::vector<int> calls;
+    Handler handler{&calls, 1, {}};
+    auto* route = demux.addRoute("/a", "org.test", "changed", &handle, &handler);
+    demux.removeRoute(route);
+
+    ASSERT_THAT(demux.dispatch("/a", "org.test", "changed", nullptr, nullptr), Eq(0u));
+    ASSERT_TRUE(calls.empty());
+}
+
+TEST(ASignalDemultiplexer, SkipsRouteRemovedByAnotherHandlerOfTheSameSignal)
+{
+    sdbus::internal::SignalDemultiplexer demux;
+    std::vector<int> calls;
+    Handler first{&calls, 1, {}}, second{&calls, 2, {}};
+    auto* firstRoute = demux.addRoute("/a", "org.test", "changed", &handle, &first);
+    auto* secondRoute = demux.addRoute("/a", "org.test", "changed", &handle, &second);
+    first.action = [&](){ demux.removeRoute(secondRoute); };
+    second.action = [&](){ demux.removeRoute(firstRoute); };
+
+    auto dispatched = demux.dispatch("/a", "org.test", "changed", nullptr, nullptr);
+
+    ASSERT_THAT(dispatched, Eq(1u));
+    ASSERT_THAT(calls.size(), Eq(1u));
+}
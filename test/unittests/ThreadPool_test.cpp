@@ -0,0 +1,168 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file ThreadPool_test.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadPool.h"
+#include <sdbus-c++/IExecutor.h>
+#include <sdbus-c++/Error.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <future>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+using ::testing::Eq;
+using ::testing::Ne;
+using namespace std::chrono_literals;
+
+TEST(AThreadPool, CannotBeCreatedWithoutThreads)
+{
+    ASSERT_THROW(sdbus::internal::ThreadPool(0), sdbus::Error);
+}
+
+TEST(AThreadPool, HasOneThreadPerCpuWhenCreatedWithDefaultThreadCount)
+{
+    auto pool = sdbus::createThreadPool();
+
+    auto& threadPool = dynamic_cast<sdbus::internal::ThreadPool&>(*pool);
+    ASSERT_THAT(threadPool.getThreadCount(), Eq(std::max(std::thread::hardware_concurrency(), 1u)));
+}
+
+TEST(AThreadPool, RunsSubmittedTasks)
+{
+    sdbus::internal::ThreadPool pool{2};
+    std::promise<std::thread::id> executed;
+
+    pool.execute([&](){ executed.set_value(std::this_thread::get_id()); });
+
+    auto future = executed.get_future();
+    ASSERT_THAT(future.wait_for(1s), Eq(std::future_status::ready));
+    ASSERT_THAT(future.get(), Ne(std::this_thread::get_id()));
+}
+
+TEST(AThreadPool, RunsTasksSubmittedFromOutsideInOrderOfSubmission)
+{
+    sdbus::internal::ThreadPool pool{1};
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::vector<int> order;
+
+    // The thread is held up until all tasks are queued
+    pool.execute([released](){ released.wait(); });
+    for (int i = 0; i < 5; ++i)
+        pool.execute([&order, i](){ order.push_back(i); });
+    release.set_value();
+
+    std::promise<void> done;
+    pool.execute([&](){ done.set_value(); });
+    ASSERT_THAT(done.get_future().wait_for(1s), Eq(std::future_status::ready));
+    ASSERT_THAT(order, Eq(std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(AThreadPool, RunsTasksSpawnedByATaskMostRecentFirstAndAheadOfSubmittedTasks)
+{
+    sdbus::internal::ThreadPool pool{1};
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::vector<int> order;
+
+    pool.execute([&, released]()
+    {
+        released.wait();
+        for (int i = 0; i < 3; ++i)
+            pool.execute([&order, i](){ order.push_back(i); });
+    });
+    pool.execute([&order](){ order.push_back(-1); });
+    release.set_value();
+
+    std::promise<void> done;
+    pool.execute([&](){ done.set_value(); });
+    ASSERT_THAT(done.get_future().wait_for(1s), Eq(std::future_status::ready));
+    ASSERT_THAT(order, Eq(std::vector<int>{2, 1, 0, -1}));
+}
+
+TEST(AThreadPool, LetsIdleThreadStealTasksQueuedBehindABlockedTask)
+{
+    sdbus::internal::ThreadPool pool{2};
+    std::promise<void> stolenDone;
+    std::promise<std::future_status> blockerDone;
+
+    // The second task is submitted from within the first one, so it lands in the queue of the
+    // first one's thread; it can only run if the other thread steals it while the first one waits
+    pool.execute([&]()
+    {
+        pool.execute([&](){ stolenDone.set_value(); });
+        blockerDone.set_value(stolenDone.get_future().wait_for(1s));
+    });
+
+    ASSERT_THAT(blockerDone.get_future().get(), Eq(std::future_status::ready));
+}
+
+TEST(AThreadPool, FinishesSubmittedTasksWhenDestroyed)
+{
+    std::atomic<int> counter{};
+    {
+        sdbus::internal::ThreadPool pool{3};
+        for (int i = 0; i < 30; ++i)
+            pool.execute([&counter](){ std::this_thread::sleep_for(1ms); ++counter; });
+    }
+
+    ASSERT_THAT(counter.load(), Eq(30));
+}
+
+TEST(AThreadPool, KeepsRunningTasksAfterATaskThrows)
+{
+    std::atomic<int> counter{};
+    {
+        sdbus::internal::ThreadPool pool{1};
+        pool.execute([](){ throw std::runtime_error("Task failed"); });
+        pool.execute([&counter](){ ++counter; });
+    }
+
+    ASSERT_THAT(counter.load(), Eq(1));
+}
+
+TEST(AThreadPool, RunsAllTasksSubmittedConcurrentlyFromManyThreads)
+{
+    std::atomic<int> counter{};
+    {
+        sdbus::internal::ThreadPool pool{4};
+        std::vector<std::thread> submitters;
+        for (int t = 0; t < 4; ++t)
+            submitters.emplace_back([&]()
+            {
+                for (int i = 0; i < 1000; ++i)
+                    pool.execute([&counter](){ ++counter; });
+            });
+        for (auto& submitter : submitters)
+            submitter.join();
+    }
+
+    ASSERT_THAT(counter.load(), Eq(4000));
+}
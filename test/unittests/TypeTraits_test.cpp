@@ -129,6 +129,31 @@ TYPED_TEST(Type2DBusTypeSignatureConversion, ConvertsTypeToProperDBusSignature)
     ASSERT_THAT(sdbus::signature_of<TypeParam>::str(), Eq(this->dbusTypeSignature_));
 }
 
+TYPED_TEST(Type2DBusTypeSignatureConversion, ConvertsTypeToProperDBusSignatureAtCompileTime)
+{
+    constexpr auto signature = sdbus::signature_of_v<TypeParam>;
+
+    ASSERT_THAT(signature.c_str(), ::testing::StrEq(this->dbusTypeSignature_));
+    ASSERT_THAT(signature.size(), Eq(this->dbusTypeSignature_.size()));
+}
+
+TEST(CompileTimeSignatures, ProvideStructContentsAndDictionaryEntriesWithoutEnclosingBrackets)
+{
+    static_assert(sdbus::detail::struct_content_signature_v<int32_t, std::vector<double>>.size() == 3, "Incorrect struct content signature");
+    static_assert(sdbus::detail::dict_entry_signature_v<std::string, sdbus::Variant>.c_str()[1] == 'v', "Incorrect dictionary entry signature");
+
+    ASSERT_THAT((sdbus::detail::struct_content_signature_v<int32_t, std::vector<double>>.c_str()), ::testing::StrEq("iad"));
+    ASSERT_THAT((sdbus::detail::dict_entry_signature_v<std::string, sdbus::Variant>.c_str()), ::testing::StrEq("sv"));
+}
+
+TEST(CompileTimeSignatures, LeaveContainersOfUnsupportedTypesInstantiableForValidityChecks)
+{
+    struct Unsupported {};
+
+    static_assert(sdbus::signature_of<std::vector<Unsupported>>::is_valid, "Containers are always valid D-Bus types");
+    static_assert(!sdbus::signature_of<Unsupported>::is_valid, "Unsupported type detected as valid D-Bus type");
+}
+
 TEST(FreeFunctionTypeTraits, DetectsTraitsOfTrivialSignatureFunction)
 {
     void f();
@@ -0,0 +1,157 @@
+/**
+ * (C) 2017 KISTLER INSTRUMENTE AG, Winterthur, Switzerland
+ *
+ * @file WaitBackend_test.cpp
+ *
+ * Created on: Oct 17, 2026
+ * Project: sdbus-c++
+ * Description: High-level D-Bus IPC C++ library based on sd-bus
+ *
+ * This file is part of sdbus-c++.
+ *
+ * sdbus-c++ is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * sdbus-c++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sdbus-c++. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WaitBackend.h"
+#include <sdbus-c++/Error.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+using ::testing::Eq;
+using ::testing::Ge;
+using namespace std::chrono_literals;
+
+namespace
+{
+    template <typename _Backend>
+    class AWaitBackend : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            exitFd_ = eventfd(0, EFD_SEMAPHORE | EFD_CLOEXEC | EFD_NONBLOCK);
+            wakeUpFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            ASSERT_THAT(pipe(busFds_), Eq(0));
+
+            try
+            {
+                backend_ = std::make_unique<_Backend>(exitFd_, wakeUpFd_);
+            }
+            catch (const sdbus::Error& e)
+            {
+                GTEST_SKIP() << "Backend not available: " << e.what();
+            }
+        }
+
+        void TearDown() override
+        {
+            backend_.reset();
+            close(busFds_[0]);
+            close(busFds_[1]);
+            close(wakeUpFd_);
+            close(exitFd_);
+        }
+
+        static void signal(int fd)
+        {
+            uint64_t value = 1;
+            ASSERT_THAT(write(fd, &value, sizeof(value)), Eq(sizeof(value)));
+        }
+
+        static void clear(int fd)
+        {
+            uint64_t value{};
+            (void)read(fd, &value, sizeof(value));
+        }
+
+        sdbus::internal::ISdBus::PollData pollData(uint64_t timeout_usec = UINT64_MAX) const
+        {
+            return {busFds_[0], POLLIN, timeout_usec};
+        }
+
+        static uint64_t now()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        int exitFd_{-1};
+        int wakeUpFd_{-1};
+        int busFds_[2]{-1, -1};
+        std::unique_ptr<sdbus::internal::IWaitBackend> backend_;
+    };
+
+    using WaitBackendTypes = ::testing::Types<sdbus::internal::PollWaitBackend, sdbus::internal::IoUringWaitBackend>;
+    TYPED_TEST_SUITE(AWaitBackend, WaitBackendTypes);
+}
+
+TYPED_TEST(AWaitBackend, ReportsExitRequest)
+{
+    this->signal(this->exitFd_);
+
+    auto events = this->backend_->wait(this->pollData());
+
+    ASSERT_TRUE(events.exitRequested);
+    ASSERT_FALSE(events.wakeUpRequested);
+}
+
+TYPED_TEST(AWaitBackend, ReportsWakeUpRequest)
+{
+    this->signal(this->wakeUpFd_);
+
+    auto events = this->backend_->wait(this->pollData());
+
+    ASSERT_FALSE(events.exitRequested);
+    ASSERT_TRUE(events.wakeUpRequested);
+}
+
+TYPED_TEST(AWaitBackend, ReturnsWhenBusBecomesReadable)
+{
+    ASSERT_THAT(write(this->busFds_[1], "x", 1), Eq(1));
+
+    auto events = this->backend_->wait(this->pollData());
+
+    ASSERT_FALSE(events.exitRequested);
+    ASSERT_FALSE(events.wakeUpRequested);
+}
+
+TYPED_TEST(AWaitBackend, ReturnsWhenBusTimeoutElapses)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    auto events = this->backend_->wait(this->pollData(this->now() + 20000));
+
+    ASSERT_THAT(std::chrono::steady_clock::now() - start, Ge(20ms));
+    ASSERT_FALSE(events.exitRequested);
+    ASSERT_FALSE(events.wakeUpRequested);
+}
+
+TYPED_TEST(AWaitBackend, ReportsRepeatedWakeUpRequestsAcrossWaits)
+{
+    for (int i = 0; i < 5; ++i)
+    {
+        this->signal(this->wakeUpFd_);
+
+        auto events = this->backend_->wait(this->pollData());
+
+        ASSERT_TRUE(events.wakeUpRequested);
+        this->clear(this->wakeUpFd_);
+    }
+}